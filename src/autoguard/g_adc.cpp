@@ -5,6 +5,7 @@
 
 #include <cstring>
 
+#include "gsystem.h"
 #include "drivers.h"
 
 
@@ -23,7 +24,40 @@ static gtimer_t adc_timeout = {};
 static gtimer_t error       = {};
 static bool adc_started     = false;
 static bool adc_error       = false;
+static volatile bool adc_posted = false;
 
+#if !defined(GSYSTEM_NO_POWER_W)
+extern "C" void power_watchdog_check();
+#endif
+
+
+static void _adc_start()
+{
+#   ifdef STM32F1
+	HAL_ADCEx_Calibration_Start(&hadc1);
+#   endif
+	if (HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_buff, __arr_len(adc_buff)) == HAL_OK) {
+		adc_started = true;
+	}
+}
+
+static void _adc_conv_handler(void*)
+{
+	if (adc_buff[0]) {
+		memcpy((uint8_t*)SYSTEM_ADC_VOLTAGE, (uint8_t*)adc_buff, sizeof(adc_buff));
+	}
+	adc_posted = false;
+
+#if !defined(GSYSTEM_NO_POWER_W)
+	power_watchdog_check();
+#endif
+
+	// Restarts before the software start and after the errors are left to adc_watchdog_check()
+	if (!is_status(SYSTEM_SOFTWARE_STARTED) || adc_error || adc_started) {
+		return;
+	}
+	_adc_start();
+}
 
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef*)
 {
@@ -37,6 +71,7 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef*)
 		adc_error = true;
 		gtimer_start(&error, GSYSTEM_ADC_ERROR_MS);
 	}
+	adc_posted = system_post(_adc_conv_handler, NULL);
 }
 
 void HAL_ADC_ErrorCallback(ADC_HandleTypeDef*)
@@ -60,19 +95,15 @@ extern "C" void adc_watchdog_check()
 		SYSTEM_ADC_VOLTAGE[0] = 0;
 	}
 
-	if (adc_started) {
+	// The conversion is handled by the posted _adc_conv_handler
+	if (adc_started || adc_posted) {
 		return;
 	}
 
 	if (adc_buff[0]) {
 		memcpy((uint8_t*)SYSTEM_ADC_VOLTAGE, (uint8_t*)adc_buff, sizeof(adc_buff));
 	}
-#   ifdef STM32F1
-	HAL_ADCEx_Calibration_Start(&hadc1);
-#   endif
-	if (HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_buff, __arr_len(adc_buff)) == HAL_OK) {
-		adc_started = true;
-	}
+	_adc_start();
 }
 
 #endif
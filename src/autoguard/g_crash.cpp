@@ -0,0 +1,256 @@
+/*
+ * @file g_crash.cpp
+ * @brief Fault crash dump capture and deferred persistence (GSYSTEM_CRASH_DUMP).
+ *
+ * The fault vectors (g_isr.cpp) switch to the crash stack and pass the
+ * stacked exception frame to sys_crash_capture(), which copies the frame,
+ * the fault status registers, a slice of the stack and the running scheduler
+ * job into the .noinit RAM, saves the fault to the clock backup RAM like
+ * system_error_handler() and resets the MCU at once instead of waiting in
+ * the error loop. After
+ * the reset the crash_dump_flush() system job prints the dump and stores it
+ * to the memory (StorageAT, "CRH" prefix), system_crash_dump_get() returns it.
+ *
+ * Cortex-M3/M4/M7 only: other cores keep the system_error_handler() path.
+ * The record check and the flush are built for every core (and the host
+ * tests), the capture only for the cores with the crash fault vectors.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "glog.h"
+#include "soul.h"
+#include "gutils.h"
+#include "gsystem.h"
+#include "drivers.h"
+
+
+#if defined(GSYSTEM_CRASH_DUMP)
+
+
+#if !defined(GSYSTEM_NO_MEMORY_W) && !defined(GSYSTEM_NO_STORAGE_AT)
+    #include "StorageAT.h"
+    #define CRASH_DUMP_STORAGE
+extern StorageAT storage;
+#endif
+
+#if !defined(GSYSTEM_NO_RTC_W)
+    #include "clock.h"
+
+extern "C" bool __internal_set_clock_ready();
+extern "C" bool __internal_is_clock_ready();
+extern "C" bool __internal_set_clock_ram(const uint8_t idx, uint8_t data);
+#endif
+
+
+static constexpr uint32_t CRASH_MAGIC = 0x43525348; // "CRSH"
+static constexpr uint32_t FRAME_WORDS = 8;          // r0-r3, r12, lr, pc, xPSR
+static constexpr uint32_t STACK_WORDS = 128;        // Crash stack, the capture and the backup RAM write
+
+
+/* Dump kept over the reset, validated by the magic and the hash */
+struct CrashRecord {
+    uint32_t          magic;
+    uint32_t          stored; // The dump has been written to the memory
+    gsys_crash_dump_t dump;
+    uint32_t          hash;
+};
+
+
+__attribute__((section(".noinit"))) static CrashRecord crash_record;
+
+static uint32_t _crash_hash()
+{
+    return util_hash((const uint8_t*)&crash_record, offsetof(CrashRecord, hash));
+}
+
+static bool _crash_valid()
+{
+    return crash_record.magic == CRASH_MAGIC && crash_record.hash == _crash_hash();
+}
+
+/* @brief Invalidate the record and return its dump to be filled in place */
+extern "C" gsys_crash_dump_t* sys_crash_dump_begin()
+{
+    crash_record.magic = 0;
+    memset(&crash_record.dump, 0, sizeof(crash_record.dump));
+    return &crash_record.dump;
+}
+
+/* @brief Seal the filled dump as a new record waiting for crash_dump_flush() */
+extern "C" void sys_crash_dump_seal()
+{
+    crash_record.magic  = CRASH_MAGIC;
+    crash_record.stored = 0;
+    crash_record.hash   = _crash_hash();
+}
+
+/* @brief The record is valid and isn't written to the memory yet */
+extern "C" bool sys_crash_dump_pending()
+{
+    return _crash_valid() && !crash_record.stored;
+}
+
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+/*
+ * The faulting stack may be the overflowed one: the fault vectors move the
+ * MSP to the top of this stack before sys_crash_capture() is called.
+ */
+__attribute__((aligned(8))) static uint32_t crash_stack[STACK_WORDS];
+extern "C" uint32_t* const sys_crash_stack_top = crash_stack + STACK_WORDS;
+
+
+extern "C" uint8_t sys_running_job_id();
+
+/* @brief Save the fault as the last reload error, see system_error_handler() */
+static void _crash_backup(SOUL_STATUS error)
+{
+#if !defined(GSYSTEM_NO_RTC_W)
+	#if defined(GSYSTEM_DOUBLE_BKCP_ENABLE)
+    if (!__internal_is_clock_ready()) {
+    	__internal_set_clock_ready();
+    }
+    if (__internal_is_clock_ready()) {
+        for (uint8_t i = 0; i < sizeof(error); i++) {
+        	__internal_set_clock_ram(i, ((uint8_t*)&error)[i]);
+        }
+    }
+	#endif
+    if (!is_clock_ready()) {
+        set_clock_ready();
+    }
+    if (is_clock_ready()) {
+        for (uint8_t i = 0; i < sizeof(error); i++) {
+            set_clock_ram(i, ((uint8_t*)&error)[i]);
+        }
+    }
+#else
+    (void)error;
+#endif
+}
+
+extern "C" void __attribute__((noreturn)) sys_crash_capture(uint32_t* frame, uint32_t exc_return, uint32_t fault)
+{
+    __disable_irq();
+
+    gsys_crash_dump_t* dump = sys_crash_dump_begin();
+    dump->fault      = fault;
+    dump->exc_return = exc_return;
+    dump->sp         = (uint32_t)frame;
+    dump->time_ms    = system_millis();
+    dump->job_id     = sys_running_job_id();
+    dump->cfsr       = SCB->CFSR;
+    dump->hfsr       = SCB->HFSR;
+    dump->mmfar      = SCB->MMFAR;
+    dump->bfar       = SCB->BFAR;
+
+    // The stack pointer may be broken (stack overflow), read only the RAM
+    uint32_t* ram_start = g_ram_start();
+    uint32_t* ram_end   = g_ram_end();
+    if (frame >= ram_start && frame + FRAME_WORDS <= ram_end) {
+        dump->r0   = frame[0];
+        dump->r1   = frame[1];
+        dump->r2   = frame[2];
+        dump->r3   = frame[3];
+        dump->r12  = frame[4];
+        dump->lr   = frame[5];
+        dump->pc   = frame[6];
+        dump->xpsr = frame[7];
+
+        uint32_t* stack = frame + FRAME_WORDS;
+        uint32_t  words = (uint32_t)__min((uint32_t)(ram_end - stack), (uint32_t)GSYSTEM_CRASH_STACK_WORDS);
+        for (uint32_t i = 0; i < words; i++) {
+            dump->stack[i] = stack[i];
+        }
+        dump->stack_words = (uint8_t)words;
+    }
+
+    sys_crash_dump_seal();
+
+    _crash_backup((SOUL_STATUS)fault);
+
+    __DSB();
+    NVIC_SystemReset();
+    while (1);
+}
+#endif
+
+extern "C" bool system_crash_dump_get(gsys_crash_dump_t* dump)
+{
+    if (!dump || !_crash_valid()) {
+        return false;
+    }
+    *dump = crash_record.dump;
+    return true;
+}
+
+extern "C" void system_crash_dump_clear(void)
+{
+    crash_record.magic = 0;
+}
+
+extern "C" void crash_dump_flush()
+{
+    if (!sys_crash_dump_pending()) {
+        return;
+    }
+
+    static bool shown = false;
+    if (!shown) {
+        shown = true;
+        const gsys_crash_dump_t* dump = &crash_record.dump;
+        SYSTEM_BEDUG(
+            "crash dump: " SOUL_STATUS_FMT " pc=0x%08lX lr=0x%08lX xpsr=0x%08lX cfsr=0x%08lX hfsr=0x%08lX job=%u",
+            SOUL_STATUS_ARG((SOUL_STATUS)dump->fault), dump->pc, dump->lr, dump->xpsr,
+            dump->cfsr, dump->hfsr, (unsigned)dump->job_id
+        );
+    }
+
+#if defined(CRASH_DUMP_STORAGE)
+    static const char PREFIX[] = "CRH";
+
+    if (!is_status(MEMORY_INITIALIZED) || is_status(MEMORY_WRITE_FAULT) || is_error(MEMORY_ERROR)) {
+        return;
+    }
+
+    uint32_t address = 0;
+    StorageStatus status = storage.find(FIND_MODE_EQUAL, &address, PREFIX, 1);
+    if (status == STORAGE_NOT_FOUND) {
+        status = storage.find(FIND_MODE_EMPTY, &address);
+    }
+    if (status != STORAGE_OK) {
+        SYSTEM_BEDUG("crash dump: find err=%02X", status);
+        return;
+    }
+    status = storage.rewrite(address, PREFIX, 1, (uint8_t*)&crash_record.dump, sizeof(crash_record.dump));
+    if (status != STORAGE_OK) {
+        SYSTEM_BEDUG("crash dump: save err=%02X addr=%lu", status, address);
+        return;
+    }
+#endif
+
+    crash_record.stored = 1;
+    crash_record.hash   = _crash_hash();
+}
+
+
+#else
+
+
+extern "C" bool system_crash_dump_get(gsys_crash_dump_t*)
+{
+    return false;
+}
+
+extern "C" void system_crash_dump_clear(void) {}
+
+
+#endif
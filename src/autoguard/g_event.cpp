@@ -0,0 +1,157 @@
+/*
+ * @file g_event.cpp
+ * @brief Publish/subscribe broker for system events.
+ *
+ * Subscribers are declared at compile time with GSYSTEM_EVENT_SUBSCRIBERS
+ * (see gconfig.example.h) and live in a const (flash) table. Published events
+ * are stored in a fixed pool and delivered by reference from system_tick()
+ * through the system_post() queue, so events may be published from
+ * interrupt handlers. Topics without subscribers are dropped at once.
+ * system_reset() is here as the last delivery of the broker: the reset
+ * event goes to the subscribers before the reboot.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdint>
+
+#include "gsystem.h"
+#include "drivers.h"
+
+
+extern "C" void sys_post_drain();
+
+
+static_assert(
+    GSYSTEM_EVENT_POOL_SIZE > 0 && GSYSTEM_EVENT_POOL_SIZE <= 32,
+    "GSYSTEM_EVENT_POOL_SIZE must be in range [1, 32]"
+);
+
+
+struct EventSubscriber {
+    uint16_t topic;
+    void     (*handler)(const gsys_event_t*);
+};
+
+
+#if defined(GSYSTEM_EVENT_SUBSCRIBERS)
+    #define GSYS_EVENT_SUBSCRIBER_DECLARE(TOPIC, HANDLER) extern "C" void HANDLER(const gsys_event_t*);
+    #define GSYS_EVENT_SUBSCRIBER_ENTRY(TOPIC, HANDLER)   {(uint16_t)(TOPIC), HANDLER},
+
+GSYSTEM_EVENT_SUBSCRIBERS(GSYS_EVENT_SUBSCRIBER_DECLARE)
+
+static constexpr EventSubscriber subscribers[] = {
+    GSYSTEM_EVENT_SUBSCRIBERS(GSYS_EVENT_SUBSCRIBER_ENTRY)
+    {GSYS_EVENT_TOPIC_NONE, NULL}
+};
+
+    #undef GSYS_EVENT_SUBSCRIBER_DECLARE
+    #undef GSYS_EVENT_SUBSCRIBER_ENTRY
+#else
+static constexpr EventSubscriber subscribers[] = {
+    {GSYS_EVENT_TOPIC_NONE, NULL}
+};
+#endif
+
+
+static constexpr uint32_t _topics_mask(uint32_t idx = 0)
+{
+    return idx >= __arr_len(subscribers) ? 0 :
+        ((subscribers[idx].handler && subscribers[idx].topic < 32) ? (1UL << subscribers[idx].topic) : 0) |
+        _topics_mask(idx + 1);
+}
+
+static constexpr bool _has_user_topics(uint32_t idx = 0)
+{
+    return idx < __arr_len(subscribers) &&
+        ((subscribers[idx].handler && subscribers[idx].topic >= 32) || _has_user_topics(idx + 1));
+}
+
+/* @brief Bitmask of system topics (< 32) which have at least one subscriber. */
+static constexpr uint32_t TOPICS_MASK    = _topics_mask();
+static constexpr bool     HAS_USER_TOPIC = _has_user_topics();
+
+
+static gsys_event_t events_pool[GSYSTEM_EVENT_POOL_SIZE] = {};
+static volatile uint32_t events_busy = 0;
+
+
+static bool _has_subscribers(uint16_t topic)
+{
+    if (topic < 32) {
+        return TOPICS_MASK & (1UL << topic);
+    }
+    return HAS_USER_TOPIC;
+}
+
+static gsys_event_t* _event_alloc()
+{
+    while (true) {
+        uint32_t busy = g_atomic_load(&events_busy);
+        uint32_t free_mask = ~busy;
+        if (GSYSTEM_EVENT_POOL_SIZE < 32) {
+            free_mask &= (1UL << GSYSTEM_EVENT_POOL_SIZE) - 1;
+        }
+        if (!free_mask) {
+            return NULL;
+        }
+        uint32_t idx = (uint32_t)__builtin_ctz(free_mask);
+        if (g_atomic_cas(&events_busy, busy, busy | (1UL << idx))) {
+            return &events_pool[idx];
+        }
+    }
+}
+
+static void _event_free(gsys_event_t* event)
+{
+    uint32_t idx = (uint32_t)(event - events_pool);
+    g_atomic_fetch_and(&events_busy, ~(uint32_t)(1U << idx));
+}
+
+static void _event_dispatch(void* arg)
+{
+    gsys_event_t* event = (gsys_event_t*)arg;
+    for (uint32_t i = 0; i < __arr_len(subscribers); i++) {
+        if (subscribers[i].handler && subscribers[i].topic == event->topic) {
+            subscribers[i].handler(event);
+        }
+    }
+    _event_free(event);
+}
+
+extern "C" bool system_event_publish(uint16_t topic, uint32_t value, uint32_t arg, const void* data)
+{
+    if (!_has_subscribers(topic)) {
+        return true;
+    }
+
+    gsys_event_t* event = _event_alloc();
+    if (!event) {
+        return false;
+    }
+
+    event->topic = topic;
+    event->value = value;
+    event->arg   = arg;
+    event->data  = data;
+
+    if (!system_post(_event_dispatch, event)) {
+        _event_free(event);
+        return false;
+    }
+    return true;
+}
+
+extern "C" void system_reset(void)
+{
+    // Deliver the reset event and the rest of the deferred work before the reset,
+    // called from an interrupt handler or a posted callback the event is only published
+    system_event_publish(GSYS_EVENT_RESET, 0, 0, NULL);
+    sys_post_drain();
+
+    system_before_reset();
+    g_reboot();
+}
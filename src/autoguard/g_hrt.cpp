@@ -0,0 +1,180 @@
+/*
+ * @file g_hrt.cpp
+ * @brief High-resolution one-shot timers multiplexed on one hardware timer (GSYSTEM_HRT_TIMER).
+ *
+ * GSYSTEM_HRT_TIMER runs as a free running 16-bit 1 us counter, the timer
+ * interrupts extend it to 32-bit time. Pending timers are caller-owned
+ * gsys_hrt_t nodes in a list sorted by deadline, the channel 1 compare is
+ * programmed for the list head and reprogrammed on every compare, so any
+ * number of one-shot timers share one peripheral. Callbacks are called from
+ * the timer interrupt (GSYSTEM_HRT_TIMER_PRIO).
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdint>
+
+#include "glog.h"
+#include "gsystem.h"
+#include "drivers.h"
+
+
+#if defined(GSYSTEM_HRT_TIMER)
+
+
+static constexpr uint32_t HRT_DELAY_MAX_US   = 0x7FFFFFFF;
+// Farther deadlines are reached through the intermediate compares
+static constexpr uint32_t HRT_COMPARE_MAX_US = 0xF000;
+
+
+static gsys_hrt_t* hrt_head     = NULL;
+static uint32_t    hrt_time_us  = 0;
+static uint16_t    hrt_last_cnt = 0;
+static bool        hrt_started  = false;
+
+
+/*
+ * @brief Extended 32-bit counter time, must be called with the timer
+ *        interrupt masked more often than once per counter period: the
+ *        overflow interrupts alone are a whole period apart and add nothing,
+ *        the compare interrupts come at least every HRT_COMPARE_MAX_US.
+ */
+static uint32_t _hrt_now_us()
+{
+    uint16_t cnt  = g_hw_timer_count(GSYSTEM_HRT_TIMER);
+    hrt_time_us  += (uint16_t)(cnt - hrt_last_cnt);
+    hrt_last_cnt  = cnt;
+    return hrt_time_us;
+}
+
+static void _hrt_schedule()
+{
+    while (hrt_head) {
+        int32_t left_us = (int32_t)(hrt_head->deadline_us - _hrt_now_us());
+        if (left_us <= 0) {
+            gsys_hrt_t* timer = hrt_head;
+            hrt_head          = timer->next;
+            timer->next       = NULL;
+            timer->pending    = false;
+            timer->callback(timer->arg);
+            continue;
+        }
+
+        uint32_t compare_us = __min((uint32_t)left_us, HRT_COMPARE_MAX_US);
+        uint32_t compare_at = hrt_time_us + compare_us;
+        g_hw_timer_set_compare(GSYSTEM_HRT_TIMER, (uint16_t)(hrt_last_cnt + compare_us));
+        // The counter may pass the compare value while it is programmed
+        if ((int32_t)(compare_at - _hrt_now_us()) > 0) {
+            return;
+        }
+    }
+    g_hw_timer_stop_compare(GSYSTEM_HRT_TIMER);
+}
+
+static void _hrt_isr_callback()
+{
+    _hrt_schedule();
+}
+
+static void _hrt_unlink(gsys_hrt_t* timer)
+{
+    for (gsys_hrt_t** it = &hrt_head; *it; it = &(*it)->next) {
+        if (*it == timer) {
+            *it            = timer->next;
+            timer->next    = NULL;
+            timer->pending = false;
+            return;
+        }
+    }
+}
+
+extern "C" bool system_hrt_start(gsys_hrt_t* timer, uint32_t delay_us, void (*callback)(void*), void* arg)
+{
+    if (!timer || !callback || delay_us > HRT_DELAY_MAX_US) {
+        BEDUG_ASSERT(false, "HRT: invalid timer");
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!hrt_started) {
+        hrt_started = g_hw_timer_start_free_us(GSYSTEM_HRT_TIMER, _hrt_isr_callback, GSYSTEM_HRT_TIMER_PRIO);
+        if (!hrt_started) {
+            __set_PRIMASK(primask);
+            return false;
+        }
+        hrt_last_cnt = g_hw_timer_count(GSYSTEM_HRT_TIMER);
+    }
+
+    if (timer->pending) {
+        _hrt_unlink(timer);
+    }
+
+    timer->deadline_us = _hrt_now_us() + delay_us;
+    timer->callback    = callback;
+    timer->arg         = arg;
+    timer->pending     = true;
+
+    gsys_hrt_t** it = &hrt_head;
+    while (*it && (int32_t)((*it)->deadline_us - timer->deadline_us) <= 0) {
+        it = &(*it)->next;
+    }
+    timer->next = *it;
+    *it         = timer;
+
+    if (hrt_head == timer) {
+        // The compare interrupt reprograms the channel for the new head
+        g_hw_timer_force_compare(GSYSTEM_HRT_TIMER);
+    }
+
+    __set_PRIMASK(primask);
+    return true;
+}
+
+extern "C" void system_hrt_stop(gsys_hrt_t* timer)
+{
+    if (!timer) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (timer->pending) {
+        _hrt_unlink(timer);
+    }
+    __set_PRIMASK(primask);
+}
+
+extern "C" bool system_hrt_pending(const gsys_hrt_t* timer)
+{
+    return timer && timer->pending;
+}
+
+
+#else
+
+
+extern "C" bool system_hrt_start(gsys_hrt_t*, uint32_t, void (*)(void*), void*)
+{
+    return false;
+}
+
+extern "C" void system_hrt_stop(gsys_hrt_t*) {}
+
+extern "C" bool system_hrt_pending(const gsys_hrt_t*)
+{
+    return false;
+}
+
+
+#endif
+
+
+extern "C" uint32_t system_hw_timers_unclaimed(void)
+{
+    return g_hw_timers_unclaimed();
+}
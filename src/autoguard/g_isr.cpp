@@ -52,24 +52,51 @@ extern "C" void __attribute__((naked)) gsys_NMI_Handler(void)
 	NMI_Handler();
 }
 
+#if defined(GSYSTEM_CRASH_DUMP) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+extern "C" void sys_crash_capture(uint32_t* frame, uint32_t exc_return, uint32_t fault);
+extern "C" uint32_t* const sys_crash_stack_top;
+
+/*
+ * @brief Pass the stacked frame (MSP or PSP by EXC_RETURN bit 2) to sys_crash_capture()
+ *        on the crash stack: the faulting MSP may be overflowed, the capture never returns.
+ */
+    #define GSYS_FAULT_HANDLER(FAULT)                     \
+	__asm volatile(                                       \
+		"tst   lr, #4                               \n"     \
+		"ite   eq                                   \n"     \
+		"mrseq r0, msp                              \n"     \
+		"mrsne r0, psp                              \n"     \
+		"mov   r1, lr                               \n"     \
+		"mov   r2, %0                               \n"     \
+		"movw  r3, #:lower16:sys_crash_stack_top    \n"     \
+		"movt  r3, #:upper16:sys_crash_stack_top    \n"     \
+		"ldr   r3, [r3]                             \n"     \
+		"mov   sp, r3                               \n"     \
+		"b     sys_crash_capture                    \n"     \
+		:: "i" (FAULT)                                    \
+	)
+#else
+    #define GSYS_FAULT_HANDLER(FAULT) system_error_handler(FAULT)
+#endif
+
 extern "C" void __attribute__((naked)) gsys_HardFault_Handler(void)
 {
-	system_error_handler(HARD_FAULT);
+	GSYS_FAULT_HANDLER(HARD_FAULT);
 }
 
 extern "C" void __attribute__((naked)) gsys_MemManage_Handler(void)
 {
-	system_error_handler(MEM_MANAGE);
+	GSYS_FAULT_HANDLER(MEM_MANAGE);
 }
 
 extern "C" void __attribute__((naked)) gsys_BusFault_Handler(void)
 {
-	system_error_handler(BUS_FAULT);
+	GSYS_FAULT_HANDLER(BUS_FAULT);
 }
 
 extern "C" void __attribute__((naked)) gsys_UsageFault_Handler(void)
 {
-	system_error_handler(USAGE_FAULT);
+	GSYS_FAULT_HANDLER(USAGE_FAULT);
 }
 
 
@@ -0,0 +1,118 @@
+/*
+ * @file g_post.cpp
+ * @brief Deferred work queue from interrupt handlers to the main loop.
+ *
+ * system_post() stores a callback in a bounded lock-free multi-producer
+ * ring (D. Vyukov's sequence-per-cell scheme), so interrupt handlers of any
+ * priority can post without IRQ masking (ARMv6-M masks the interrupts for
+ * the single compare-and-swap, see g_atomic_cas()). The ring is drained by
+ * system_tick() before the periodic jobs.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdint>
+
+#include "gsystem.h"
+#include "drivers.h"
+
+
+static_assert(
+    GSYSTEM_POST_QUEUE_SIZE && !(GSYSTEM_POST_QUEUE_SIZE & (GSYSTEM_POST_QUEUE_SIZE - 1)),
+    "GSYSTEM_POST_QUEUE_SIZE must be a power of 2"
+);
+
+
+/*
+ * Cell sequence is stored relative to the cell index, so the zero
+ * initialized ring is ready before any constructor or init call
+ * (interrupt handlers may post before system_init()).
+ */
+struct PostCell {
+    volatile uint32_t seq;
+    void (*fn)(void*);
+    void* arg;
+};
+
+static constexpr uint32_t POST_MASK = GSYSTEM_POST_QUEUE_SIZE - 1;
+
+static PostCell post_cells[GSYSTEM_POST_QUEUE_SIZE];
+static volatile uint32_t post_head     = 0;     // Producers position
+static volatile uint32_t post_dropped  = 0;
+static uint32_t          post_tail     = 0;     // Consumer (main loop) position
+static bool              post_draining = false; // Consumer is running the callbacks
+
+
+static uint32_t _cell_seq(const uint32_t pos)
+{
+    return g_atomic_load(&post_cells[pos & POST_MASK].seq) + (pos & POST_MASK);
+}
+
+static void _cell_set_seq(const uint32_t pos, const uint32_t seq)
+{
+    g_atomic_store(&post_cells[pos & POST_MASK].seq, seq - (pos & POST_MASK));
+}
+
+extern "C" bool system_post(void (*fn)(void*), void* arg)
+{
+    if (!fn) {
+        return false;
+    }
+
+    uint32_t pos = g_atomic_load(&post_head);
+    while (true) {
+        int32_t diff = (int32_t)(_cell_seq(pos) - pos);
+        if (diff == 0) {
+            if (g_atomic_cas(&post_head, pos, pos + 1)) {
+                post_cells[pos & POST_MASK].fn  = fn;
+                post_cells[pos & POST_MASK].arg = arg;
+                _cell_set_seq(pos, pos + 1);
+                return true;
+            }
+        } else if (diff < 0) {
+            g_atomic_fetch_add(&post_dropped, 1);
+            return false;
+        }
+        // Another producer took the cell
+        pos = g_atomic_load(&post_head);
+    }
+}
+
+extern "C" bool sys_post_empty()
+{
+    return (int32_t)(_cell_seq(post_tail) - (post_tail + 1)) < 0;
+}
+
+extern "C" void sys_post_drain()
+{
+    // Single consumer: interrupt handlers and the posted callbacks (system_reset(),
+    // yields) don't drain, the work is left to the running drain or the main loop
+    if (post_draining || __get_IPSR()) {
+        return;
+    }
+    post_draining = true;
+
+    // Work posted while draining waits for the next pass
+    uint32_t end = g_atomic_load(&post_head);
+    while (post_tail != end) {
+        if (sys_post_empty()) {
+            break;
+        }
+
+        void (*fn)(void*) = post_cells[post_tail & POST_MASK].fn;
+        void* arg         = post_cells[post_tail & POST_MASK].arg;
+        _cell_set_seq(post_tail, post_tail + GSYSTEM_POST_QUEUE_SIZE);
+        post_tail++;
+
+        fn(arg);
+    }
+    post_draining = false;
+
+    uint32_t dropped = g_atomic_exchange(&post_dropped, 0);
+    if (dropped) {
+        SYSTEM_BEDUG("system_post queue overflow: %lu dropped", dropped);
+    }
+}
@@ -5,7 +5,9 @@
  *
  * Implements the adaptive scheduler used by the system to balance periodic
  * tasks, collect execution timings and present lightweight profiling info
- * in debug builds.
+ * in debug builds. Main-loop jobs are kept in a deadline-ordered queue, so
+ * a scheduler pass only touches the jobs which are due. The job table is
+ * split into the compact scheduling part (Job) and the statistics (JobStats).
  *
  * Copyright © 2025 Georgy E. All rights reserved.
  */
@@ -19,7 +21,6 @@
 #include "gsystem.h"
 #include "gversion.h"
 #include "g_settings.h"
-#include "circle_buf_gc.h"
 
 #include "gtimer.h"
 #include "TypeListService.h"
@@ -41,6 +42,22 @@ static void _device_rev_show();
 static void _scheduler_load_show();
 static void _scheduler_recompute_scaling();
 static void _scheduler_error_check();
+#if defined(GSYSTEM_ISR_TIMER)
+static void _scheduler_isr_callback();
+#endif
+
+extern "C" void sys_post_drain();
+extern "C" bool sys_post_empty();
+extern "C" void sys_twheel_tick();
+extern "C" uint64_t sys_twheel_next_ms();
+
+#if defined(GSYSTEM_TRACE)
+extern "C" void sys_trace_record(uint8_t job_id, uint64_t start_us, uint32_t duration_us, uint8_t flags);
+    #define GSYS_TRACE_JOB(JOB, START_US, DURATION_US, DENY) \
+        sys_trace_record((JOB)->id, (START_US), (uint32_t)(DURATION_US), (uint8_t)(((JOB)->isr ? 1 : 0) | ((DENY) << 1)))
+#else
+    #define GSYS_TRACE_JOB(JOB, START_US, DURATION_US, DENY)
+#endif
 
 
 static constexpr uint32_t RECOMPUTE_MS         = 200;
@@ -51,99 +68,232 @@ static constexpr uint32_t FIX                  = 100;
 static constexpr uint32_t LOAD_SCALE           = 10000;
 static constexpr uint32_t JOB_SCALE_MAX_X100   = 9000000;
 static constexpr uint32_t LOAD_SHOW_DELAY_MS   = SECOND_MS;
-static constexpr uint32_t JOBS_BUF_SIZE        = GSYSTEM_MIN_PROCCESS_CNT + GSYSTEM_POCESSES_COUNT;
+static constexpr uint32_t ISR_REARM_MAX_US     = 50 * MILLIS_US;
 
+static constexpr uint8_t  DENY_NONE            = 0;
+static constexpr uint8_t  DENY_ERROR_HANDLER   = 1;
+static constexpr uint8_t  DENY_MCU_ERROR       = 2;
 
-struct Job {
-	static constexpr uint32_t MAX_DELAY_MS = MINUTE_MS;
 
-    void       (*action)(void)     = NULL;
-    uint32_t   orig_delay_ms       = 0;      // Original period
-    uint32_t   current_delay_ms    = 0;      // Real calculated period
-    bool       work_with_error     = false;  // Work with error flag
-    bool       realtime            = false;  // Scale disable flag
-    bool       system_task         = false;  // System task flag
+#ifndef GSYSTEM_NO_MEMORY_W
+extern "C" void memory_watchdog_check();
+#endif
+#ifndef GSYSTEM_NO_SYS_TICK_W
+extern "C" void sys_clock_watchdog_check();
+#endif
+#ifndef GSYSTEM_NO_RAM_W
+extern "C" void ram_watchdog_check();
+#endif
+#if !defined(GSYSTEM_NO_ADC_W)
+extern "C" void adc_watchdog_check();
+#endif
+#if defined(STM32F1) && !defined(GSYSTEM_NO_I2C_W)
+extern "C" void i2c_watchdog_check();
+#endif
+#if !defined(GSYSTEM_NO_POWER_W) && !defined(GSYSTEM_NO_ADC_W)
+extern "C" void power_watchdog_check();
+#endif
+#ifndef GSYSTEM_NO_RTC_W
+extern "C" void rtc_watchdog_check();
+#endif
+#ifndef GSYSTEM_NO_DEVICE_SETTINGS
+extern "C" void settings_update();
+#endif
+extern "C" void btn_watchdog_check();
 
-    uint64_t   last_start_us       = 0;      // Start time
-    uint64_t   last_end_us         = 0;      // End time
+#if defined(GSYSTEM_SOUL_LOG) && !defined(GSYSTEM_NO_MEMORY_W) && !defined(GSYSTEM_NO_STORAGE_AT)
+    #define GSYSTEM_SOUL_LOG_FLUSH
+extern "C" void soul_log_flush();
+#endif
 
-    uint32_t   last_exec_sum_us    = 0;
-    uint32_t   last_average_us     = 0;
-    uint32_t   exec_sum_us         = 0;
-    uint64_t   exec_sum_start_us   = 0;
+#if defined(GSYSTEM_CRASH_DUMP)
+extern "C" void crash_dump_flush();
+#endif
 
-    uint32_t   scale_x100          = 0;
-    uint8_t    priority            = GSYSTEM_PROCCESS_PRIORITY_DEFAULT;
+/*
+ * Job descriptor: the part of the job which is not changed by the scheduler.
+ * The built-in jobs read it from the constant (flash) table by the job id,
+ * only the scheduling state of the job is kept in RAM.
+ */
+struct JobDesc {
+    void     (*action)(void);
+    uint32_t delay_ms;
+    bool     realtime;
+    bool     work_with_error;
+};
 
-#if !defined(GSYSTEM_NO_PROC_INFO)
-    uint32_t   last_max_exec_us     = 0;
-    uint32_t   max_exec_us          = 0;     // Max execution time
+static constexpr JobDesc SYS_JOBS[] = {
+    {_scheduler_load_show,         LOAD_SHOW_DELAY_MS, true,  true},
+    {_scheduler_recompute_scaling, RECOMPUTE_MS,       true,  true},
+    {_scheduler_error_check,       200,                true,  true},
+#ifndef GSYSTEM_NO_MEMORY_W
+    {memory_watchdog_check,        100,                false, true},
 #endif
-    uint32_t   last_exec_counter    = 0;
-    uint32_t   exec_counter         = 0;     // Execution counter
-    bool       isr                  = false;
+#ifndef GSYSTEM_NO_SYS_TICK_W
+    {sys_clock_watchdog_check,     SECOND_MS / 10,     false, true},
+#endif
+#ifndef GSYSTEM_NO_RAM_W
+    {ram_watchdog_check,           5 * SECOND_MS,      false, true},
+#endif
+#if !defined(GSYSTEM_NO_ADC_W)
+    {adc_watchdog_check,           10,                 true,  true},
+#endif
+#if defined(STM32F1) && !defined(GSYSTEM_NO_I2C_W)
+    {i2c_watchdog_check,           5 * SECOND_MS,      false, true},
+#endif
+#ifndef GSYSTEM_NO_RTC_W
+    {rtc_watchdog_check,           SECOND_MS,          false, true},
+#endif
+#if !defined(GSYSTEM_NO_POWER_W) && !defined(GSYSTEM_NO_ADC_W)
+    {power_watchdog_check,         100,                true,  true},
+#endif
+#ifndef GSYSTEM_NO_DEVICE_SETTINGS
+    {settings_update,              500,                false, false},
+#endif
+#if defined(GSYSTEM_SOUL_LOG_FLUSH)
+    {soul_log_flush,               SECOND_MS,          false, true},
+#endif
+#if defined(GSYSTEM_CRASH_DUMP)
+    {crash_dump_flush,             SECOND_MS,          false, true},
+#endif
+    {btn_watchdog_check,           5,                  false, true}
+};
 
+static constexpr uint32_t SYS_JOBS_COUNT       = __arr_len(SYS_JOBS);
+static constexpr uint32_t JOBS_BUF_SIZE        = SYS_JOBS_COUNT + GSYSTEM_POCESSES_COUNT;
 
-    Job() {}
+static_assert(JOBS_BUF_SIZE < 0xFF, "GSYSTEM_POCESSES_COUNT is too large: job ids and handles are 8-bit");
 
-    Job(
-        void     (*action)(void),
-        uint32_t delay_ms,
-        bool     realtime        = false,
-        bool     work_with_error = false,
-        uint8_t  priority        = GSYSTEM_PROCCESS_PRIORITY_DEFAULT,
-        bool     isr             = false
-    ):
-        action(action), orig_delay_ms(delay_ms), current_delay_ms(delay_ms),
-        work_with_error(work_with_error), realtime(realtime), system_task(false),
-        last_start_us(0), last_end_us(0), last_exec_sum_us(0), last_average_us(0),
-        exec_sum_us(0), exec_sum_start_us(0), scale_x100(0), priority(priority),
-#if !defined(GSYSTEM_NO_PROC_INFO)
-    	last_max_exec_us(0), max_exec_us(0),
-#endif
-        last_exec_counter(0), exec_counter(0), isr(isr)
-    {}
-    
-    bool denied()
+/*
+ * Descriptors of the user jobs by the job id (starting from SYS_JOBS_COUNT),
+ * a free slot has no action.
+ */
+static JobDesc user_jobs[GSYSTEM_POCESSES_COUNT] = {};
+
+
+#if defined(GSYSTEM_PROC_HISTOGRAM)
+/*
+ * Log2-bucket histogram of microsecond durations: bucket 0 counts zero
+ * durations, bucket k counts [2^(k-1), 2^k) us, the last bucket counts
+ * everything longer. Counters are halved together on saturation, so the
+ * percentiles keep the proportions of the recent history.
+ */
+class JobHistogram {
+public:
+    static constexpr uint32_t BUCKETS = 18;
+
+private:
+    uint16_t buckets[BUCKETS];
+
+public:
+    constexpr JobHistogram(): buckets{} {}
+
+    void add(uint32_t value_us)
     {
-        bool _denied = is_status(SYSTEM_ERROR_HANDLER_CALLED) && !work_with_error;
-        if (system_task) {
-            return _denied;
+        uint32_t idx = value_us ? (uint32_t)(32 - __builtin_clz(value_us)) : 0;
+        if (idx >= BUCKETS) {
+            idx = BUCKETS - 1;
         }
-        if (is_mcu_internal_error()) {
-            return true;
+        if (buckets[idx] == 0xFFFF) {
+            for (uint32_t i = 0; i < BUCKETS; i++) {
+                buckets[i] /= 2;
+            }
         }
-        return _denied;
+        buckets[idx]++;
     }
 
-    void updateCount(uint64_t now_us = system_micros())
+    /* @return upper bound of the bucket with the permille percentile (lower bound for the last bucket) */
+    uint32_t percentile_us(uint32_t permille) const
+    {
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            total += buckets[i];
+        }
+        if (!total) {
+            return 0;
+        }
+
+        uint32_t target = __div_up(total * permille, 1000);
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < BUCKETS - 1; i++) {
+            sum += buckets[i];
+            if (sum >= target) {
+                return i ? ((1U << i) - 1) : 0;
+            }
+        }
+        return 1U << (BUCKETS - 2);
+    }
+
+    void reset()
+    {
+        memset(buckets, 0, sizeof(buckets));
+    }
+};
+#endif
+
+/*
+ * Cold part of the job: execution statistics used by the adaptive scaling
+ * and the status output. It is kept in a separate array indexed by Job::id,
+ * so the scheduler pass only walks the compact Job table.
+ */
+struct JobStats {
+    uint32_t   last_exec_sum_us     = 0;
+    uint32_t   exec_sum_us          = 0;
+    uint64_t   exec_sum_start_us    = 0;
+    uint32_t   scale_x100           = 0;
+    uint32_t   last_exec_counter    = 0;
+    uint32_t   exec_counter         = 0;     // Execution counter
+    uint32_t   overruns             = 0;     // Missed ISR job periods
+#if defined(GSYSTEM_SCHEDULER_EDF)
+    uint32_t   deadline_misses      = 0;
+#endif
+#if !defined(GSYSTEM_NO_PROC_INFO)
+    uint32_t   last_average_us      = 0;
+    uint32_t   last_max_exec_us     = 0;
+    uint32_t   max_exec_us          = 0;     // Max execution time
+#endif
+#if defined(GSYSTEM_PROC_HISTOGRAM)
+    JobHistogram exec_hist;                  // Execution time histogram
+    JobHistogram jitter_hist;                // Start minus due time histogram
+#endif
+
+    /*
+     * @brief Decay the load of a job idle for more than a second. Called by rescale()
+     *        every RECOMPUTE_MS: the load is multiplied by EXEC_SMOOTH_ALPHA % per 200 ms,
+     *        the time constant is ~1.9 s (10% of the load is left after ~4.4 s) and
+     *        doesn't depend on the system_tick() pass rate.
+     */
+    void updateCount(uint64_t now_us, uint64_t last_end_us)
     {
         if (last_end_us + SECOND_US < now_us) {
             last_exec_sum_us = (last_exec_sum_us * EXEC_SMOOTH_ALPHA) / 100;
         }
     }
 
-    void exec(uint64_t now_us = system_micros())
+    void add(uint64_t start_us, uint64_t end_us, bool executed)
     {
-        last_start_us = now_us;
-        if (action) {
-            action();
+        if (executed) {
             exec_counter++;
         }
-        last_end_us = system_micros();
 
-        if (exec_sum_start_us + SECOND_US < last_end_us) {
-            uint32_t last_period = (uint32_t)(last_end_us > exec_sum_start_us ? last_end_us - exec_sum_start_us : SECOND_US);
-            last_exec_sum_us = (uint32_t)__proportion((uint64_t)exec_sum_us, 0, (uint64_t)last_period, 0, (uint64_t)SECOND_US);
+        if (exec_sum_start_us + SECOND_US < end_us) {
+            // A job launched after a long idle time: the period doesn't fit 32 bits
+            uint64_t last_period = end_us > exec_sum_start_us ? end_us - exec_sum_start_us : SECOND_US;
+            last_exec_sum_us = (uint32_t)__proportion((uint64_t)exec_sum_us, 0, last_period, 0, (uint64_t)SECOND_US);
+#if !defined(GSYSTEM_NO_PROC_INFO)
             last_average_us = exec_sum_us / (exec_counter > 0 ? exec_counter : 1);
-            exec_sum_start_us = last_end_us;
+#endif
+            exec_sum_start_us = end_us;
             exec_sum_us = 0;
-            last_exec_counter = (uint32_t)__proportion((uint64_t)exec_counter, 0, (uint64_t)last_period, 0, (uint64_t)SECOND_US);
+            last_exec_counter = (uint32_t)__proportion((uint64_t)exec_counter, 0, last_period, 0, (uint64_t)SECOND_US);
             exec_counter = 0;
         }
 
-        uint32_t dur_us = (uint32_t)((last_end_us > last_start_us) ? (last_end_us - last_start_us) : 0);
+        uint32_t dur_us = (uint32_t)((end_us > start_us) ? (end_us - start_us) : 0);
         exec_sum_us += dur_us;
+#if defined(GSYSTEM_PROC_HISTOGRAM)
+        exec_hist.add(dur_us);
+#endif
 #if !defined(GSYSTEM_NO_PROC_INFO)
         if (max_exec_us < dur_us) {
             last_max_exec_us = dur_us;
@@ -156,17 +306,349 @@ struct Job {
     {
         return (uint32_t)__proportion((uint64_t)last_exec_sum_us, 0, (uint64_t)SECOND_US, 0, (uint64_t)LOAD_SCALE);
     }
+
+    /* @brief Execution time per second used by the adaptive scaling */
+    uint32_t get_scale_exec_sum_us()
+    {
+#if defined(GSYSTEM_PROC_SCALE_P99)
+        uint64_t p99_sum_us = (uint64_t)exec_hist.percentile_us(990) * last_exec_counter;
+        return (uint32_t)__min(__max(p99_sum_us, (uint64_t)last_exec_sum_us), (uint64_t)SECOND_US);
+#else
+        return last_exec_sum_us;
+#endif
+    }
+
+    uint32_t get_scale_load_x100()
+    {
+        return (uint32_t)__proportion((uint64_t)get_scale_exec_sum_us(), 0, (uint64_t)SECOND_US, 0, (uint64_t)LOAD_SCALE);
+    }
+};
+
+static JobStats jobs_stats[JOBS_BUF_SIZE] = {};
+
+/*
+ * System state checked before a job launch. It is recomputed only when the
+ * soul generation changes, so a scheduler pass doesn't walk the status
+ * bitmap for every job.
+ */
+struct JobDenyState {
+    uint32_t generation    = 0;
+    bool     valid         = false;
+    bool     error_handler = false;
+    bool     mcu_error     = false;
+
+    void refresh()
+    {
+        uint32_t current = get_soul_generation();
+        if (valid && generation == current) {
+            return;
+        }
+        error_handler = is_status(SYSTEM_ERROR_HANDLER_CALLED);
+        mcu_error     = is_mcu_internal_error();
+        generation    = current;
+        valid         = true;
+    }
+};
+
+/*
+ * Hot part of the job: the scheduling state used by every scheduler pass,
+ * the action, the period and the flags are read from the job descriptor.
+ */
+struct Job {
+	static constexpr uint32_t MAX_DELAY_MS = MINUTE_MS;
+
+    using Action = void (*)(void);
+
+    uint64_t   next_us             = 0;      // Next launch time (job queue key)
+    uint64_t   last_end_us         = 0;      // End time
+#if defined(GSYSTEM_SCHEDULER_EDF)
+    uint64_t   abs_deadline_us     = 0;      // Absolute deadline (ready queue key)
+    uint32_t   wcet_us             = 0;      // Declared worst case execution time
+    uint32_t   deadline_us         = 0;      // Relative deadline
+#endif
+    uint32_t   period_us           = 0;      // ISR job period
+    uint32_t   current_delay_ms    = 0;      // Real calculated period
+    uint16_t   queue_pos           = 0;      // Position in the job queue
+    uint8_t    id                  = 0;      // Index in the jobs table
+    uint8_t    gen                 = 0;      // Slot generation (job handle check)
+    uint8_t    priority            = GSYSTEM_PROCCESS_PRIORITY_DEFAULT;
+    bool       isr             : 1;
+    bool       suspended       : 1;          // Job is out of the queues
+#if defined(GSYSTEM_SCHEDULER_EDF)
+    bool       edf             : 1;          // Job with WCET budget and deadline
+#endif
+
+
+    constexpr Job():
+        isr(false), suspended(false)
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        , edf(false)
+#endif
+    {}
+
+    Job(
+        uint32_t delay_ms,
+        uint8_t  priority = GSYSTEM_PROCCESS_PRIORITY_DEFAULT,
+        bool     isr      = false
+    ):
+        next_us(delay_ms * MILLIS_US), last_end_us(0),
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        abs_deadline_us(0), wcet_us(0), deadline_us(0),
+#endif
+        period_us(delay_ms * MILLIS_US), current_delay_ms(delay_ms),
+        queue_pos(0), id(0), gen(0), priority(priority),
+        isr(isr), suspended(false)
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        , edf(false)
+#endif
+    {}
+
+    JobStats& stats()
+    {
+        return jobs_stats[id];
+    }
+
+    /* @brief Built-in jobs take the first ids and are never removed */
+    bool system_task() const
+    {
+        return id < SYS_JOBS_COUNT;
+    }
+
+    const JobDesc& desc() const
+    {
+        return system_task() ? SYS_JOBS[id] : user_jobs[id - SYS_JOBS_COUNT];
+    }
+
+    JobDesc& user_desc()
+    {
+        BEDUG_ASSERT(!system_task(), "The built-in job descriptors are constant");
+        return user_jobs[id - SYS_JOBS_COUNT];
+    }
+
+    Action action() const
+    {
+        return desc().action;
+    }
+
+    /* @brief Original period */
+    uint32_t orig_delay_ms() const
+    {
+        return desc().delay_ms;
+    }
+
+    /* @brief Scale disable flag */
+    bool realtime() const
+    {
+        return desc().realtime;
+    }
+
+    bool work_with_error() const
+    {
+        return desc().work_with_error;
+    }
+
+    /* @brief The job is registered (free slots have no action) and is not suspended */
+    bool active()
+    {
+        return action() && !suspended;
+    }
+
+    uint8_t deny_reason(const JobDenyState& state)
+    {
+        uint8_t reason = (state.error_handler && !work_with_error()) ? DENY_ERROR_HANDLER : DENY_NONE;
+        if (system_task()) {
+            return reason;
+        }
+        if (state.mcu_error) {
+            return DENY_MCU_ERROR;
+        }
+        return reason;
+    }
+
+    void exec(uint64_t now_us = system_micros(), uint64_t due_us = 0)
+    {
+#if defined(GSYSTEM_PROC_HISTOGRAM)
+        if (due_us) {
+            stats().jitter_hist.add(now_us > due_us ? (uint32_t)__min(now_us - due_us, (uint64_t)0xFFFFFFFF) : 0);
+        }
+#else
+        (void)due_us;
+#endif
+        Action action = this->action();
+        if (action) {
+            action();
+        }
+        last_end_us = system_micros();
+        next_us = last_end_us + (uint64_t)current_delay_ms * MILLIS_US;
+
+        stats().add(now_us, last_end_us, action != NULL);
+    }
+};
+
+/*
+ * Binary min-heap of job pointers ordered by the KEY time: the launch time
+ * (Job::next_us) or the absolute deadline in the EDF ready queue. Jobs with
+ * equal times are taken in the priority order (the lower value first).
+ * The scheduler pass only touches jobs which are due, so its cost does not
+ * depend on the number of sleeping jobs. Job::queue_pos keeps the heap slot
+ * of the job (1-based, 0 - the job is not queued) for O(log n) updates,
+ * a job is kept in one queue at a time.
+ */
+template<uint64_t Job::*KEY>
+class JobHeap {
+private:
+    Job*     heap[JOBS_BUF_SIZE];
+    uint16_t size;
+
+    static bool before(const Job* a, const Job* b)
+    {
+        return a->*KEY < b->*KEY || (a->*KEY == b->*KEY && a->priority < b->priority);
+    }
+
+    bool less(uint16_t a, uint16_t b)
+    {
+        return before(heap[a], heap[b]);
+    }
+
+    void place(uint16_t idx, Job* job)
+    {
+        heap[idx] = job;
+        job->queue_pos = (uint16_t)(idx + 1);
+    }
+
+    void sift_up(uint16_t idx)
+    {
+        Job* job = heap[idx];
+        while (idx > 0) {
+            uint16_t parent = (uint16_t)((idx - 1) / 2);
+            if (!before(job, heap[parent])) {
+                break;
+            }
+            place(idx, heap[parent]);
+            idx = parent;
+        }
+        place(idx, job);
+    }
+
+    void sift_down(uint16_t idx)
+    {
+        Job* job = heap[idx];
+        while (true) {
+            uint16_t child = (uint16_t)(2 * idx + 1);
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && less((uint16_t)(child + 1), child)) {
+                child++;
+            }
+            if (!before(heap[child], job)) {
+                break;
+            }
+            place(idx, heap[child]);
+            idx = child;
+        }
+        place(idx, job);
+    }
+
+public:
+    JobHeap(): heap{}, size(0) {}
+
+    bool empty()
+    {
+        return !size;
+    }
+
+    uint16_t count()
+    {
+        return size;
+    }
+
+    Job* top()
+    {
+        return size ? heap[0] : NULL;
+    }
+
+    bool push(Job* const job)
+    {
+        if (size >= __arr_len(heap) || job->queue_pos) {
+            return false;
+        }
+        place(size, job);
+        sift_up(size++);
+        return true;
+    }
+
+    Job* pop()
+    {
+        if (!size) {
+            return NULL;
+        }
+        Job* job = heap[0];
+        job->queue_pos = 0;
+        if (--size) {
+            place(0, heap[size]);
+            sift_down(0);
+        }
+        return job;
+    }
+
+    bool contains(Job* const job)
+    {
+        return job->queue_pos && job->queue_pos <= size && heap[job->queue_pos - 1] == job;
+    }
+
+    void remove(Job* const job)
+    {
+        if (!contains(job)) {
+            return;
+        }
+        uint16_t idx = (uint16_t)(job->queue_pos - 1);
+        job->queue_pos = 0;
+        if (idx == --size) {
+            return;
+        }
+        place(idx, heap[size]);
+        sift_down(idx);
+        sift_up((uint16_t)(heap[idx]->queue_pos - 1));
+    }
+
+    void update(Job* const job)
+    {
+        if (!job->queue_pos) {
+            return;
+        }
+        uint16_t idx = (uint16_t)(job->queue_pos - 1);
+        sift_up(idx);
+        sift_down((uint16_t)(job->queue_pos - 1));
+    }
 };
 
-static circle_buf_gc_t jobs = {};
-static Job jobs_buf[JOBS_BUF_SIZE] = {};
+using JobQueue = JobHeap<&Job::next_us>;
+#if defined(GSYSTEM_SCHEDULER_EDF)
+using JobReadyQueue = JobHeap<&Job::abs_deadline_us>;
+#endif
+
+static Job jobs[JOBS_BUF_SIZE] = {};
 
 class Scheduler {
 private:
     const uint32_t LOAD_WRN_X100 = 500;
     const uint32_t LOAD_ERR_X100 = 1000;
 
-	circle_buf_gc_t* const jobs;
+    uint32_t   jobs_cnt;            // Used slots high-water mark
+    Job*       running_job;         // Main loop job being executed
+    Job*       running_isr_job;     // ISR job being executed
+
+    JobDenyState deny_state;      // Main loop launch checks cache
+    JobDenyState isr_deny_state;  // ISR tier launch checks cache
+
+    JobQueue   queue;
+    JobQueue   isr_queue;
+#if defined(GSYSTEM_SCHEDULER_EDF)
+    JobQueue      edf_queue;   // EDF jobs waiting for the release
+    JobReadyQueue edf_ready;   // Released EDF jobs ordered by the deadline
+    uint32_t      edf_load_x100;
+#endif
 
     uint32_t   smooth_scale_x100;
     uint32_t   last_recompute_ms;
@@ -178,12 +660,39 @@ private:
     uint32_t   TPC_counter;
     uint32_t   last_TPC_counter;
 
-    uint32_t   isr_job_idx;
+    uint32_t   pass_exec_us;        // Jobs execution time of the current pass
+    uint32_t   pass_overhead_sum_us;
+    uint32_t   last_pass_overhead_ns;
+
+    uint32_t   isr_load_x100;
+    uint32_t   isr_budget_hits;
+    bool       isr_timer_started;
+
+    bool       started;
+    uint16_t   phase_seq;
 
     uint32_t   last_sum_reset_us;
 
     uint32_t   jobs_scale_x100;
 
+    /*
+     * Phase offset of the next added job: the van der Corput sequence
+     * (0, 1/2, 1/4, 3/4, 1/8, ...) of the period, so jobs with equal or
+     * harmonic periods are spread evenly across the period.
+     */
+    uint64_t next_phase_us(uint64_t period_us)
+    {
+        if (period_us <= MILLIS_US) {
+            return 0;
+        }
+        uint32_t seq = phase_seq++;
+        uint32_t fraction = 0;
+        for (uint32_t i = 0; i < 16; i++) {
+            fraction = (fraction << 1) | ((seq >> i) & 0x01);
+        }
+        return (period_us * fraction) >> 16;
+    }
+
     void print_div_line()
     {
 #if defined(GSYSTEM_PROC_PROC_ENABLE)
@@ -192,102 +701,539 @@ private:
     }
 
 public:
-    Scheduler(
-        circle_buf_gc_t* const jobs,
-        Job* const jobs_buf,
-        const uint32_t jobs_cnt,
-        std::initializer_list<Job> sys_jobs
-    ):
-        jobs(jobs), smooth_scale_x100(100), last_recompute_ms(0),
+    Scheduler():
+        jobs_cnt(0), running_job(NULL), running_isr_job(NULL), deny_state(), isr_deny_state(), queue(), isr_queue(),
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        edf_queue(), edf_ready(), edf_load_x100(0),
+#endif
+        smooth_scale_x100(100), last_recompute_ms(0),
         last_scale_x100(0), err_timer(0),
         TPC_timer(SECOND_MS), TPC_counter(0), last_TPC_counter(0),
-        isr_job_idx(0), last_sum_reset_us(0), jobs_scale_x100(0)
+        pass_exec_us(0), pass_overhead_sum_us(0), last_pass_overhead_ns(0),
+        isr_load_x100(0), isr_budget_hits(0), isr_timer_started(false),
+        started(false), phase_seq(0),
+        last_sum_reset_us(0), jobs_scale_x100(0)
     {
-        BEDUG_ASSERT(
-		    circle_buf_gc_init(jobs, (uint8_t*)jobs_buf, sizeof(Job), jobs_cnt),
-            "GSystem jobs buffer initialization error"
-        )
-        for (unsigned i = 0 ; i < sys_jobs.size(); i++) {
-            Job* job = (Job*)((Job*)sys_jobs.begin() + i);
-            job->system_task = true;
-            add_task(job);
+        for (uint32_t i = 0; i < __arr_len(jobs); i++) {
+            jobs[i].id = (uint8_t)i;
+        }
+        for (const JobDesc& desc : SYS_JOBS) {
+            Job job(desc.delay_ms, GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false);
+            add_task(&job, desc, true);
         }
     }
 
     void init()
     {
-        _device_rev_show();
+        _device_rev_show();
+
+        SYSTEM_BEDUG(
+            "scheduler RAM: jobs %lu B (%lu x %lu B), user descriptors %lu B, stats %lu B (%lu x %lu B), queues %lu B",
+            (uint32_t)sizeof(jobs), (uint32_t)__arr_len(jobs), (uint32_t)sizeof(Job), (uint32_t)sizeof(user_jobs),
+            (uint32_t)sizeof(jobs_stats), (uint32_t)__arr_len(jobs_stats), (uint32_t)sizeof(JobStats),
+            queues_ram()
+        );
+
+        started = true;
+
+#if defined(GSYSTEM_ISR_TIMER)
+        isr_timer_started = g_hw_timer_start_us(GSYSTEM_ISR_TIMER, _scheduler_isr_callback, ISR_REARM_MAX_US, GSYSTEM_ISR_TIMER_PRIO);
+        BEDUG_ASSERT(isr_timer_started, "GSystem ISR timer start error");
+#endif
+    }
+
+    uint32_t queues_ram() const
+    {
+        return (uint32_t)(sizeof(queue) + sizeof(isr_queue)
+#if defined(GSYSTEM_SCHEDULER_EDF)
+            + sizeof(edf_queue) + sizeof(edf_ready)
+#endif
+        );
+    }
+
+    Job* add_task(Job* const job, const JobDesc& desc, bool system_task = false)
+    {
+        BEDUG_ASSERT(!full(), "GSystem jobs is out of range");
+        if (full()) {
+            return NULL;
+        }
+
+		job->current_delay_ms = desc.delay_ms;
+        job->priority = clamp_priority(job->priority, system_task);
+
+        job->queue_pos = 0;
+        if (job->isr) {
+            job->next_us  = system_micros() + job->period_us;
+        } else {
+            // Built-in jobs are added before the system timer start
+            uint64_t base_us = started ? system_micros() : job->last_end_us;
+            uint64_t period_us = (uint64_t)job->current_delay_ms * MILLIS_US;
+            job->next_us  = base_us + period_us + next_phase_us(period_us);
+        }
+
+        uint32_t idx = free_slot();
+        BEDUG_ASSERT(system_task == (idx < SYS_JOBS_COUNT), "The built-in jobs must take the first slots");
+        if (idx == jobs_cnt) {
+            jobs_cnt++;
+        }
+        uint8_t gen = jobs[idx].gen;
+        job->id = (uint8_t)idx;
+        jobs[idx] = *job;
+        jobs[idx].gen = gen;
+        jobs_stats[idx] = JobStats();
+        if (!system_task) {
+            JobDesc& user = jobs[idx].user_desc();
+            user = desc;
+            // ISR jobs are not scaled
+            user.realtime = desc.realtime || job->isr;
+        }
+
+        Job* added = &jobs[idx];
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (added->edf) {
+            added->next_us = system_micros() + added->period_us + next_phase_us(added->period_us);
+            edf_load_x100 += edf_density_x100(added);
+        }
+#endif
+        enqueue(added);
+
+        return added;
+    }
+
+    static uint8_t clamp_priority(uint32_t priority, bool system_task)
+    {
+        if (priority <= GSYSTEM_INTERNAL_PROCCESS_PRIORITY && !system_task) {
+            priority = GSYSTEM_INTERNAL_PROCCESS_PRIORITY + 1;
+        }
+        if (priority > GSYSTEM_PROCCESS_PRIORITY_MAX) {
+            priority = GSYSTEM_PROCCESS_PRIORITY_MAX;
+        }
+        return (uint8_t)priority;
+    }
+
+    /* @brief First removed slot (the running jobs slots are kept until their launch ends) or the next new one */
+    uint32_t free_slot()
+    {
+        for (uint32_t i = 0; i < jobs_cnt; i++) {
+            Job* job = &jobs[i];
+            if (!job->action() && job != running_job && job != running_isr_job) {
+                return i;
+            }
+        }
+        return jobs_cnt;
+    }
+
+    void enqueue(Job* const job)
+    {
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (job->edf) {
+            edf_queue.push(job);
+            return;
+        }
+#endif
+        if (!job->isr) {
+            queue.push(job);
+            return;
+        }
+
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        isr_queue.push(job);
+        rearm_isr();
+        __set_PRIMASK(primask);
+    }
+
+    void dequeue(Job* const job)
+    {
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (job->edf) {
+            edf_queue.remove(job);
+            edf_ready.remove(job);
+            return;
+        }
+#endif
+        if (!job->isr) {
+            queue.remove(job);
+            return;
+        }
+
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        isr_queue.remove(job);
+        __set_PRIMASK(primask);
+    }
+
+    static gsys_job_t job_handle(Job* const job)
+    {
+        return job ? (((gsys_job_t)job->gen << 8) | (gsys_job_t)(job->id + 1)) : GSYS_JOB_INVALID;
+    }
+
+    /* @brief Registered user job of the handle, NULL for stale handles and the built-in jobs */
+    Job* job_by_handle(gsys_job_t handle)
+    {
+        uint32_t idx = (handle & 0xFF);
+        if (!idx || idx > jobs_cnt) {
+            return NULL;
+        }
+        Job* job = &jobs[idx - 1];
+        if (!job->action() || job->system_task() || job->gen != (uint8_t)(handle >> 8)) {
+            return NULL;
+        }
+        return job;
+    }
+
+    void suspend(Job* const job)
+    {
+        if (job->suspended) {
+            return;
+        }
+        job->suspended = true;
+        dequeue(job);
+    }
+
+    void resume(Job* const job)
+    {
+        if (!job->suspended) {
+            return;
+        }
+        job->suspended = false;
+        if (job == running_job || job == running_isr_job) {
+            // The running job is queued back at the end of its launch
+            return;
+        }
+        uint64_t period_us = job->isr || job_is_edf(job) ? job->period_us : (uint64_t)job->current_delay_ms * MILLIS_US;
+        job->next_us = system_micros() + period_us;
+        enqueue(job);
+    }
+
+    void remove(Job* const job)
+    {
+        suspend(job);
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (job->edf) {
+            edf_load_x100 -= __min(edf_density_x100(job), edf_load_x100);
+        }
+#endif
+        job->user_desc().action = NULL;
+        job->gen++;
+        jobs_stats[job->id] = JobStats();
+    }
+
+    bool set_period(Job* const job, uint32_t period_ms)
+    {
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (job->edf) {
+            Job updated = *job;
+            updated.period_us = period_ms * MILLIS_US;
+            uint32_t load_x100 = edf_load_x100 - __min(edf_density_x100(job), edf_load_x100);
+            if (load_x100 + edf_density_x100(&updated) > GSYSTEM_EDF_MAX_LOAD_X100) {
+                return false;
+            }
+            edf_load_x100 = load_x100 + edf_density_x100(&updated);
+        }
+#endif
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        job->user_desc().delay_ms = period_ms;
+        job->period_us = period_ms * MILLIS_US;
+        apply_delay(job, period_ms);
+        __set_PRIMASK(primask);
+        return true;
+    }
+
+    /*
+     * @brief Set the effective period of the job: the queued main loop launch
+     *        is moved by the period change only, so the launch phase (stagger
+     *        or system_job_set_phase()) is kept.
+     */
+    void apply_delay(Job* const job, uint32_t delay_ms)
+    {
+        uint32_t prev_ms = job->current_delay_ms;
+        job->current_delay_ms = delay_ms;
+        if (delay_ms == prev_ms || job->isr || job_is_edf(job) || !queue.contains(job)) {
+            return;
+        }
+        if (delay_ms > prev_ms) {
+            job->next_us += (uint64_t)(delay_ms - prev_ms) * MILLIS_US;
+        } else {
+            uint64_t shift_us = (uint64_t)(prev_ms - delay_ms) * MILLIS_US;
+            job->next_us -= __min(shift_us, job->next_us);
+        }
+        queue.update(job);
+    }
+
+    void set_priority(Job* const job, uint32_t priority)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        job->priority = clamp_priority(priority, job->system_task());
+        // The queued job moves among the jobs with the same launch time
+        if (queue.contains(job)) {
+            queue.update(job);
+        } else if (isr_queue.contains(job)) {
+            isr_queue.update(job);
+        }
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        else if (edf_queue.contains(job)) {
+            edf_queue.update(job);
+        } else if (edf_ready.contains(job)) {
+            edf_ready.update(job);
+        }
+#endif
+        __set_PRIMASK(primask);
+    }
+
+    /* @brief Scheduler pass, the nested passes of the waiting jobs (see yield()) are out of the pass stats */
+    void tick(bool nested = false)
+    {
+        if (!nested) {
+            TPC_counter++;
+        }
+
+        if (!nested && !TPC_timer.wait()) {
+            last_TPC_counter = __proportion(TPC_timer.end(), TPC_timer.getStart(), (uint32_t)system_millis(), 0, TPC_counter);
+            last_pass_overhead_ns = (uint32_t)((uint64_t)pass_overhead_sum_us * 1000 / (TPC_counter ? TPC_counter : 1));
+            TPC_timer.start();
+            TPC_counter = 0;
+            pass_overhead_sum_us = 0;
+        }
+        pass_exec_us = 0;
+
+        uint64_t now_us  = system_micros();
+        uint64_t time_us = now_us;
+        while (true) {
+#if defined(GSYSTEM_SCHEDULER_EDF)
+            // Released EDF jobs go before the best-effort jobs
+            if (edf_step(time_us)) {
+                continue;
+            }
+#endif
+            if (queue.empty() || queue.top()->next_us > now_us) {
+                break;
+            }
+
+            Job* job = queue.pop();
+            uint64_t due_us = job->next_us;
+
+            deny_state.refresh();
+            uint8_t deny = job->deny_reason(deny_state);
+            if (deny != DENY_NONE) {
+                job->next_us = now_us + (uint64_t)job->current_delay_ms * MILLIS_US;
+                GSYS_TRACE_JOB(job, now_us, 0, deny);
+            } else {
+                running_job = job;
+                job->exec(time_us, due_us);
+                running_job = NULL;
+                GSYS_TRACE_JOB(job, time_us, job->last_end_us - time_us, DENY_NONE);
+                pass_exec_us += (uint32_t)(job->last_end_us - time_us);
+                time_us = job->last_end_us;
+                // The job suspended or removed itself
+                if (!job->active()) {
+                    continue;
+                }
+            }
+
+            // Every job is launched once per pass at most
+            if (job->next_us <= now_us) {
+                job->next_us = now_us + 1;
+            }
+            queue.push(job);
+
+#if defined(GSYSTEM_PROC_INFO_ENABLE)
+            if (has_new_status_data() || has_new_error_data()) {
+                show_statuses();
+                show_errors();
+            }
+#endif
+        }
+
+#if !defined(GSYSTEM_NO_PROC_INFO)
+        // Scheduler pass cost without the jobs execution time
+        uint32_t pass_us = (uint32_t)(system_micros() - now_us);
+        if (!nested) {
+            pass_overhead_sum_us += pass_us > pass_exec_us ? pass_us - pass_exec_us : 0;
+        }
+#endif
+    }
+
+    /*
+     * @brief Scheduler pass from a waiting job: the running job is out of the
+     *        queue while it executes, so it is not launched again by the pass.
+     *        The pass is not counted in the ticks per second and the pass cost,
+     *        the jobs launched by it are counted in the waiting job time as well.
+     */
+    void yield()
+    {
+        Job* caller          = running_job;
+        uint32_t caller_exec = pass_exec_us;
+        tick(true);
+        pass_exec_us = caller_exec;
+        running_job  = caller;
+    }
+
+    bool is_started() const
+    {
+        return started;
+    }
+
+    uint8_t running_id() const
+    {
+        const Job* job = running_isr_job ? running_isr_job : running_job;
+        return job ? job->id : 0xFF;
+    }
+
+#if defined(GSYSTEM_SCHEDULER_EDF)
+    static uint32_t edf_density_x100(Job* const job)
+    {
+        uint32_t window_us = __min(job->deadline_us, job->period_us);
+        return (uint32_t)__div_up((uint64_t)job->wcet_us * LOAD_SCALE, (uint64_t)(window_us ? window_us : 1));
+    }
+
+    bool edf_admit(Job* const job)
+    {
+        return edf_load_x100 + edf_density_x100(job) <= GSYSTEM_EDF_MAX_LOAD_X100;
     }
 
-    bool add_task(Job* const job)
+    /* @brief Release the due EDF jobs and launch one with the earliest deadline, now_us is moved to the job end */
+    bool edf_step(uint64_t& now_us)
     {
-        BEDUG_ASSERT(!full(), "GSystem jobs is out of range");
-        if (full()) {
+        while (!edf_queue.empty() && edf_queue.top()->next_us <= now_us) {
+            Job* job = edf_queue.pop();
+            job->abs_deadline_us = job->next_us + job->deadline_us;
+            edf_ready.push(job);
+        }
+        if (edf_ready.empty()) {
             return false;
         }
 
-		job->current_delay_ms = job->orig_delay_ms;
-        if (job->priority <= GSYSTEM_INTERNAL_PROCCESS_PRIORITY && !job->system_task) {
-            job->priority = GSYSTEM_INTERNAL_PROCCESS_PRIORITY + 1;
-        }
-        if (job->priority > GSYSTEM_PROCCESS_PRIORITY_MAX) {
-            job->priority = GSYSTEM_PROCCESS_PRIORITY_MAX;
+        Job* job = edf_ready.pop();
+        uint64_t release_us = job->next_us;
+
+        deny_state.refresh();
+        uint8_t deny = job->deny_reason(deny_state);
+        if (deny == DENY_NONE) {
+            running_job = job;
+            job->exec(now_us, release_us);
+            running_job = NULL;
+            GSYS_TRACE_JOB(job, now_us, job->last_end_us - now_us, DENY_NONE);
+            pass_exec_us += (uint32_t)(job->last_end_us - now_us);
+            now_us = job->last_end_us;
+            if (now_us > job->abs_deadline_us) {
+                job->stats().deadline_misses++;
+            }
+            // The job suspended or removed itself
+            if (!job->active()) {
+                return true;
+            }
+        } else {
+            GSYS_TRACE_JOB(job, now_us, 0, deny);
         }
 
-		circle_buf_gc_push_back(jobs, (uint8_t*)job);
-
+        // Periodic releases, the missed ones are skipped
+        job->next_us = release_us + job->period_us;
+        if (job->next_us <= now_us) {
+            uint64_t missed = (now_us - job->next_us) / job->period_us + 1;
+            job->stats().deadline_misses += (uint32_t)missed;
+            job->next_us += missed * job->period_us;
+        }
+        edf_queue.push(job);
         return true;
     }
+#endif
 
-    void tick(bool isr = false)
+    uint64_t next_launch_us()
     {
-        if (!isr) {
-            TPC_counter++;
-
-            if (!TPC_timer.wait()) {
-                last_TPC_counter = __proportion(TPC_timer.end(), TPC_timer.getStart(), (uint32_t)system_millis(), 0, TPC_counter);
-                TPC_timer.start();
-                TPC_counter = 0;
-            }
+        uint64_t next_us = queue.empty() ? UINT64_MAX : queue.top()->next_us;
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (!edf_queue.empty()) {
+            next_us = __min(next_us, edf_queue.top()->next_us);
         }
+#endif
+        return next_us;
+    }
 
-        uint32_t len = circle_buf_gc_count(jobs);
-        if (isr_job_idx >= len) {
-            isr_job_idx = 0;
+    void idle()
+    {
+#if defined(GSYSTEM_TICKLESS_IDLE)
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+
+        uint64_t now_us  = system_micros();
+        uint64_t next_us = next_launch_us();
+        uint64_t wheel_ms = sys_twheel_next_ms();
+        if (wheel_ms != UINT64_MAX) {
+            next_us = __min(next_us, wheel_ms * MILLIS_US);
         }
-        uint32_t i = isr ? isr_job_idx : 0;
-        for (; i < len; i++) {
-            Job* job = (Job*)circle_buf_gc_index(jobs, i);
-            if (isr != job->isr) {
-                continue;
+        if (sys_post_empty() && next_us > now_us) {
+            uint32_t idle_ms = (uint32_t)__min((next_us - now_us) / MILLIS_US, (uint64_t)0xFFFF);
+            // A pending interrupt wakes WFI up even with masked interrupts
+            if (idle_ms < GSYSTEM_TICKLESS_MIN_MS || !g_sys_tick_sleep(idle_ms)) {
+                __DSB();
+                __WFI();
             }
+        }
 
-            uint64_t time_us = system_micros();
-
-            job->updateCount(time_us);
+        __set_PRIMASK(primask);
+#endif
+    }
 
-            if (job->last_end_us + job->current_delay_ms * MILLIS_US > time_us) {
-                continue;
+    void tick_isr()
+    {
+        uint64_t start_us = system_micros();
+        uint64_t now_us   = start_us;
+        while (!isr_queue.empty() && isr_queue.top()->next_us <= now_us) {
+            if (now_us - start_us >= GSYSTEM_ISR_BUDGET_US) {
+                isr_budget_hits++;
+                break;
             }
 
-            if (job->denied()) {
-                continue;
+            Job* job = isr_queue.pop();
+            uint64_t due_us = job->next_us;
+
+            isr_deny_state.refresh();
+            uint8_t deny = job->deny_reason(isr_deny_state);
+            if (deny == DENY_NONE) {
+                running_isr_job = job;
+                job->exec(now_us, due_us);
+                running_isr_job = NULL;
+                GSYS_TRACE_JOB(job, now_us, job->last_end_us - now_us, DENY_NONE);
+                now_us = job->last_end_us;
+                // The job suspended or removed itself
+                if (!job->active()) {
+                    continue;
+                }
+            } else {
+                GSYS_TRACE_JOB(job, now_us, 0, deny);
             }
 
-            job->exec(time_us);
-#if defined(GSYSTEM_PROC_INFO_ENABLE)
-            if (isr) {
-                break;
-            }
-            if (has_new_status_data() || has_new_error_data()) {
-                show_statuses();
-                show_errors();
+            // Absolute launch times: the period doesn't drift with the ISR latency
+            job->next_us = due_us + job->period_us;
+            if (job->next_us <= now_us) {
+                uint64_t missed = (now_us - job->next_us) / job->period_us + 1;
+                job->stats().overruns += (uint32_t)missed;
+                job->next_us  += missed * job->period_us;
             }
-#endif
+            isr_queue.push(job);
+        }
+
+        rearm_isr();
+    }
+
+    void rearm_isr()
+    {
+#if defined(GSYSTEM_ISR_TIMER)
+        if (!isr_timer_started) {
+            return;
         }
-        if (isr) {
-            isr_job_idx++;
+
+        uint32_t delay_us = ISR_REARM_MAX_US;
+        if (!isr_queue.empty()) {
+            uint64_t now_us  = system_micros();
+            uint64_t next_us = isr_queue.top()->next_us;
+            delay_us = next_us > now_us ? (uint32_t)__min(next_us - now_us, (uint64_t)delay_us) : 1;
         }
+        g_hw_timer_rearm_us(GSYSTEM_ISR_TIMER, delay_us);
+#endif
     }
 
     void print_status()
@@ -300,14 +1246,15 @@ public:
         uint32_t voltage = get_system_power_v_x100();
     #endif
         gprint(
-            "Build version: v%s | kTPC: %lu.%02lu"
+            "Build version: v%s | kTPC: %lu.%02lu | Pass: %lu ns"
     #if !defined(GSYSTEM_NO_ADC_W)
             "  |  CPU PWR: %lu.%02lu V"
     #endif
             "\n",
             system_device_version(),
             last_TPC_counter / 1000,
-            (last_TPC_counter / 10) % 100
+            (last_TPC_counter / 10) % 100,
+            last_pass_overhead_ns
     #if !defined(GSYSTEM_NO_ADC_W)
             ,
             voltage / 100,
@@ -322,11 +1269,12 @@ public:
 
         uint32_t total_load_x100 = 0;
         auto show = [&] (Job* job, uint32_t index) {
-            uint32_t load_percent_x100 = job->get_load_x100();
+            JobStats& stats = job->stats();
+            uint32_t load_percent_x100 = stats.get_load_x100();
             total_load_x100 += load_percent_x100;
-            uint32_t load_max_exec_us_x100 = (uint32_t)__proportion((uint64_t)job->last_max_exec_us, 0, (uint64_t)SECOND_US, 0, (uint64_t)LOAD_SCALE);
-            uint32_t scale_x100 = job->scale_x100 + LOAD_SCALE;
-            if (!job->realtime) {
+            uint32_t load_max_exec_us_x100 = (uint32_t)__proportion((uint64_t)stats.last_max_exec_us, 0, (uint64_t)SECOND_US, 0, (uint64_t)LOAD_SCALE);
+            uint32_t scale_x100 = stats.scale_x100 + LOAD_SCALE;
+            if (!job->realtime()) {
                 scale_x100 += jobs_scale_x100;
             }
 
@@ -340,48 +1288,62 @@ public:
             system_set_print_color(color);
             gprint("|");
             gprint(" %02u |", index);
-            gprint(" %10lu |", (job->current_delay_ms > job->orig_delay_ms && !job->realtime) ? job->current_delay_ms : job->orig_delay_ms);
-            gprint(" %8lu |", job->last_exec_counter);
+            if (job->isr) {
+                gprint(" %7lu us |", job->period_us);
+            } else {
+                gprint(" %10lu |", (job->current_delay_ms > job->orig_delay_ms() && !job->realtime()) ? job->current_delay_ms : job->orig_delay_ms());
+            }
+            gprint(" %8lu |", stats.last_exec_counter);
             gprint(" %4lu.%02lu |", load_percent_x100 / FIX, __abs(load_percent_x100 % FIX));
-            gprint(" %7lu |", job->last_average_us);
+            gprint(" %7lu |", stats.last_average_us);
             if (!memcmp((void*)color, (void*)GSYSTEM_COLOR_DEFAULT, strlen(GSYSTEM_COLOR_DEFAULT)) && load_max_exec_us_x100 > LOAD_WRN_X100) {
             	system_set_print_color(GSYSTEM_COLOR_WARN);
             }
-            gprint(" %7lu", job->last_max_exec_us);
+            gprint(" %7lu", stats.last_max_exec_us);
             if (!memcmp((void*)color, (void*)GSYSTEM_COLOR_DEFAULT, strlen(GSYSTEM_COLOR_DEFAULT)) && load_max_exec_us_x100 > LOAD_WRN_X100) {
             	system_set_print_color(GSYSTEM_COLOR_DEFAULT);
             }
             gprint(" | %4lu |", job->priority);
             gprint(" %5lu.%02lu |", scale_x100 / FIX, __abs(scale_x100 % FIX));
-            gprint(" %8s |", job->realtime ? "YES" : "NO");
+            gprint(" %8s |", job->realtime() ? "YES" : "NO");
         	system_set_print_color(GSYSTEM_COLOR_DEFAULT);
             gprint("\n");
 
-            job->last_max_exec_us = job->max_exec_us;
-            job->max_exec_us = 0;
+            stats.last_max_exec_us = stats.max_exec_us;
+            stats.max_exec_us = 0;
         };
 
-        for (uint32_t i = 0; i < circle_buf_gc_count(jobs); i++) {
-            Job* job  = (Job*)circle_buf_gc_index(jobs, i);
-            if (i == GSYSTEM_MIN_PROCCESS_CNT) {
+        for (uint32_t i = 0; i < jobs_cnt; i++) {
+            Job* job  = &jobs[i];
+            if (i == SYS_JOBS_COUNT) {
                 print_div_line();
             }
-            if (!job->isr) {
+            if (job->action() && !job->isr) {
                 show(job, i);
             }
         }
         print_div_line();
 
+        uint32_t main_load_x100 = total_load_x100;
         bool isr_printed = false;
-        for (uint32_t i = 0; i < circle_buf_gc_count(jobs); i++) {
-            Job* job  = (Job*)circle_buf_gc_index(jobs, i);
-            if (job->isr) {
+        uint32_t isr_overruns = 0;
+        for (uint32_t i = 0; i < jobs_cnt; i++) {
+            Job* job  = &jobs[i];
+            if (job->action() && job->isr) {
                 isr_printed = true;
+                isr_overruns += job->stats().overruns;
                 show(job, i);
             }
         }
+        total_load_x100 = main_load_x100;
         if (isr_printed) {
             print_div_line();
+            gprint(
+                "ISR load: %ld.%02ld%% | Overruns: %lu | Budget hits: %lu\n",
+                (uint32_t)(isr_load_x100 / 100), (uint32_t)(__abs(isr_load_x100 % 100)),
+                isr_overruns,
+                isr_budget_hits
+            );
         }
 
         const char* color = GSYSTEM_COLOR_DEFAULT;
@@ -402,49 +1364,171 @@ public:
 #endif
     }
 
+    bool set_phase(Job* const job, uint32_t phase_ms)
+    {
+        if (job->isr) {
+            return false;
+        }
+
+        uint64_t period_us = job_is_edf(job) ? job->period_us : (uint64_t)job->current_delay_ms * MILLIS_US;
+        if (!period_us) {
+            return false;
+        }
+        uint64_t phase_us = ((uint64_t)phase_ms * MILLIS_US) % period_us;
+        uint64_t now_us   = system_micros();
+        uint64_t next_us  = now_us - now_us % period_us + phase_us;
+        if (next_us <= now_us) {
+            next_us += period_us;
+        }
+        job->next_us = next_us;
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (job->edf) {
+            edf_queue.update(job);
+            return true;
+        }
+#endif
+        queue.update(job);
+        return true;
+    }
+
+    static bool job_is_edf(Job* const job)
+    {
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        return job->edf;
+#else
+        (void)job;
+        return false;
+#endif
+    }
+
+    Job* add_rt_task(Job* const job, const JobDesc& desc)
+    {
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        if (full() || !edf_admit(job)) {
+            return NULL;
+        }
+        return add_task(job, desc);
+#else
+        (void)job;
+        (void)desc;
+        return NULL;
+#endif
+    }
+
+    void job_stats(Job* const job, gsys_job_stats_t* const stats)
+    {
+        JobStats& job_stats = job->stats();
+        memset((void*)stats, 0, sizeof(*stats));
+        stats->action              = (uint32_t)(uintptr_t)job->action();
+        stats->period_ms           = job->orig_delay_ms();
+        stats->effective_period_ms = job->current_delay_ms;
+        stats->period_us           = job->isr ? job->period_us : job->current_delay_ms * MILLIS_US;
+        stats->load_x100           = job_stats.get_load_x100();
+#if !defined(GSYSTEM_NO_PROC_INFO)
+        stats->average_us          = job_stats.last_average_us;
+        stats->max_exec_us         = __max(job_stats.last_max_exec_us, job_stats.max_exec_us);
+#endif
+        stats->exec_counter        = job_stats.last_exec_counter;
+        stats->scale_x100          = job_stats.scale_x100 + LOAD_SCALE + (job->realtime() ? 0 : jobs_scale_x100);
+        stats->overruns            = job_stats.overruns;
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        stats->wcet_us             = job->wcet_us;
+        stats->deadline_us         = job->deadline_us;
+        stats->deadline_misses     = job_stats.deadline_misses;
+#endif
+        stats->priority            = job->priority;
+        stats->realtime            = job->realtime();
+        stats->isr                 = job->isr;
+    }
+
+    void scheduler_stats(gsys_scheduler_stats_t* const stats)
+    {
+        memset((void*)stats, 0, sizeof(*stats));
+        for (uint32_t i = 0; i < jobs_cnt; i++) {
+            Job* job = &jobs[i];
+            if (job->action()) {
+                stats->jobs_count++;
+            }
+            if (job->action() && !job->isr) {
+                stats->total_load_x100 += job->stats().get_load_x100();
+            }
+        }
+        stats->isr_load_x100    = isr_load_x100;
+        stats->target_load_x100 = TARGET_CPU_LOAD_X100;
+        stats->jobs_scale_x100  = jobs_scale_x100 + LOAD_SCALE;
+        stats->ticks_per_second = last_TPC_counter;
+        stats->pass_overhead_ns = last_pass_overhead_ns;
+        stats->isr_budget_hits  = isr_budget_hits;
+#if defined(GSYSTEM_SCHEDULER_EDF)
+        stats->edf_load_x100    = edf_load_x100;
+#endif
+        stats->jobs_ram_bytes   = (uint32_t)(sizeof(jobs) + sizeof(user_jobs)) + queues_ram();
+        stats->stats_ram_bytes  = (uint32_t)sizeof(jobs_stats);
+    }
+
     void recompute_scaling()
+    {
+        rescale();
+    }
+
+    void rescale()
     {
         uint32_t total_load_x100 = 0;
         uint32_t total_realtime_load_x100 = 0;
-        uint32_t jobs_cnt = circle_buf_gc_count(jobs);
         uint32_t realtime_jobs_cnt = 0;
+        uint32_t isr_total_load_x100 = 0;
+        uint64_t now_us = system_micros();
         for (uint32_t i = 0; i < jobs_cnt; i++) {
-            Job* job = (Job*)circle_buf_gc_index(jobs, i);
-            uint32_t load_x100 = job->get_load_x100();
+            Job* job = &jobs[i];
+            JobStats& stats = job->stats();
+            if (!job->action()) {
+                // Free slots are not scaled
+                realtime_jobs_cnt++;
+                continue;
+            }
+            if (job->isr) {
+                // ISR jobs are not scaled and have separate load statistics
+                isr_total_load_x100 += stats.get_load_x100();
+                realtime_jobs_cnt++;
+                continue;
+            }
+            stats.updateCount(now_us, job->last_end_us);
+            uint32_t load_x100 = stats.get_scale_load_x100();
             total_load_x100 += load_x100;
-            if (job->realtime) {
+            if (job->realtime()) {
                 total_realtime_load_x100 += load_x100;
-                job->current_delay_ms = job->orig_delay_ms;
+                apply_delay(job, job->orig_delay_ms());
                 realtime_jobs_cnt++;
-                job->scale_x100 = 0;
+                stats.scale_x100 = 0;
                 continue;
             }
 
-            uint32_t period_ms = job->orig_delay_ms;
+            uint32_t period_ms = job->orig_delay_ms();
             if (period_ms == 0) {
                 period_ms = 1;
             }
             
             if (load_x100 > LOAD_WRN_X100) {
                 uint32_t load_delta_x100 = load_x100 - LOAD_WRN_X100;
-                job->scale_x100 = (uint32_t)(
-                    ((uint64_t)job->last_exec_sum_us * 
+                stats.scale_x100 = (uint32_t)(
+                    ((uint64_t)stats.get_scale_exec_sum_us() * 
                     ((uint64_t)LOAD_SCALE + (uint64_t)load_delta_x100)) / 
                     (uint64_t)LOAD_WRN_X100
 				);
             } else {
-                job->scale_x100 = job->scale_x100 > 0 ? (job->scale_x100 * (100 - SCALE_SMOOTH_ALPHA) / 100) : 0;
+                stats.scale_x100 = stats.scale_x100 > 0 ? (stats.scale_x100 * (100 - SCALE_SMOOTH_ALPHA) / 100) : 0;
             }
-            if (job->scale_x100 > JOB_SCALE_MAX_X100) {
-                job->scale_x100 = JOB_SCALE_MAX_X100;
+            if (stats.scale_x100 > JOB_SCALE_MAX_X100) {
+                stats.scale_x100 = JOB_SCALE_MAX_X100;
             }
 
-            if (job->scale_x100) {
-                job->current_delay_ms = period_ms * (job->priority * FIX + job->scale_x100) / LOAD_SCALE;
+            if (stats.scale_x100) {
+                apply_delay(job, period_ms * (job->priority * FIX + stats.scale_x100) / LOAD_SCALE);
             } else {
-                job->current_delay_ms = job->orig_delay_ms;
+                apply_delay(job, job->orig_delay_ms());
             }
         }
+        isr_load_x100 = isr_total_load_x100;
 
         if (jobs_cnt <= realtime_jobs_cnt) {
             jobs_scale_x100 = 0;
@@ -467,21 +1551,21 @@ public:
         }
 
         for (uint32_t i = 0; i < jobs_cnt; i++) {
-            Job* job = (Job*)circle_buf_gc_index(jobs, i);
-            if (job->realtime) {
+            Job* job = &jobs[i];
+            if (!job->action() || job->realtime()) {
                 continue;
             }
 
-            uint32_t period_ms = job->orig_delay_ms;
+            uint32_t period_ms = job->orig_delay_ms();
             if (period_ms == 0) {
                 period_ms = 1;
             }
 
             if (jobs_scale_x100) {
-                uint32_t scale_x100 = jobs_scale_x100 + job->scale_x100;
-                job->current_delay_ms = period_ms * (job->priority * FIX + scale_x100) / LOAD_SCALE;
+                uint32_t scale_x100 = jobs_scale_x100 + job->stats().scale_x100;
+                apply_delay(job, period_ms * (job->priority * FIX + scale_x100) / LOAD_SCALE);
             } else {
-                job->current_delay_ms = job->orig_delay_ms;
+                apply_delay(job, job->orig_delay_ms());
             }
         }
     }
@@ -539,82 +1623,24 @@ public:
 
     bool full()
     {
-        return circle_buf_gc_full(jobs);
+        return free_slot() >= __arr_len(jobs);
     }
 
     unsigned job_count()
     {
-        if (circle_buf_gc_initialized(jobs)) {
-        return circle_buf_gc_count(jobs);
-        }
-        BEDUG_ASSERT(false, "GSystem jobs buffer is not initialized");
-        return 0;
+        return jobs_cnt;
+    }
+
+    Job* job_at(uint32_t idx)
+    {
+        return (idx < jobs_cnt && jobs[idx].action()) ? &jobs[idx] : NULL;
     }
 };
 
 
-#ifndef GSYSTEM_NO_MEMORY_W
-extern "C" void memory_watchdog_check();
-#endif
-#ifndef GSYSTEM_NO_SYS_TICK_W
-extern "C" void sys_clock_watchdog_check();
-#endif
-#ifndef GSYSTEM_NO_RAM_W
-extern "C" void ram_watchdog_check();
-#endif
-#if !defined(GSYSTEM_NO_ADC_W)
-extern "C" void adc_watchdog_check();
-#endif
-#if defined(STM32F1) && !defined(GSYSTEM_NO_I2C_W)
-extern "C" void i2c_watchdog_check();
-#endif
-#if !defined(GSYSTEM_NO_POWER_W) && !defined(GSYSTEM_NO_ADC_W)
-extern "C" void power_watchdog_check();
-#endif
-#ifndef GSYSTEM_NO_RTC_W
-extern "C" void rtc_watchdog_check();
-#endif
-#ifndef GSYSTEM_NO_DEVICE_SETTINGS
-extern "C" void settings_update();
-#endif
-extern "C" void btn_watchdog_check();
 extern "C" void system_scheduler_init();
 
-static Scheduler scheduler(
-    &jobs,
-    jobs_buf,
-    __arr_len(jobs_buf),
-    {
-        {_scheduler_load_show,         LOAD_SHOW_DELAY_MS, true,  true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-        {_scheduler_recompute_scaling, RECOMPUTE_MS,       true,  true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-        {_scheduler_error_check,       200,                true,  true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#ifndef GSYSTEM_NO_MEMORY_W
-        {memory_watchdog_check,        100,                false, true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#ifndef GSYSTEM_NO_SYS_TICK_W
-        {sys_clock_watchdog_check,     SECOND_MS / 10,     false, true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#ifndef GSYSTEM_NO_RAM_W
-        {ram_watchdog_check,           5 * SECOND_MS,      false, true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#if !defined(GSYSTEM_NO_ADC_W)
-        {adc_watchdog_check,           1,                  true,  true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#if defined(STM32F1) && !defined(GSYSTEM_NO_I2C_W)
-        {i2c_watchdog_check,           5 * SECOND_MS,      false, true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#ifndef GSYSTEM_NO_RTC_W
-        {rtc_watchdog_check,           SECOND_MS,          false, true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#if !defined(GSYSTEM_NO_POWER_W) && !defined(GSYSTEM_NO_ADC_W)
-        {power_watchdog_check,         1,                  true,  true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-#ifndef GSYSTEM_NO_DEVICE_SETTINGS
-        {settings_update,              500,                false, false, GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false},
-#endif
-        {btn_watchdog_check,           5,                  false, true,  GSYSTEM_INTERNAL_PROCCESS_PRIORITY, false}
-    }
-);
+static Scheduler scheduler;
 
 
 extern "C" void sys_jobs_init()
@@ -624,41 +1650,393 @@ extern "C" void sys_jobs_init()
 
 extern "C" void system_tick()
 {
-    scheduler.tick(false);
+    sys_post_drain();
+    sys_twheel_tick();
+    scheduler.tick();
+}
+
+extern "C" void system_yield_delay_us(uint64_t us)
+{
+    static bool yielding = false;
+
+    // Nested yields, interrupt handlers, masked interrupts (the system time stops) and too short waits spin
+    if (yielding || __get_IPSR() || __get_PRIMASK() || !scheduler.is_started() || us < GSYSTEM_YIELD_MIN_US) {
+        system_delay_us(us);
+        return;
+    }
+
+    yielding = true;
+    uint64_t end_us = system_micros() + us;
+    while (true) {
+        uint64_t now_us = system_micros();
+        if (now_us >= end_us) {
+            break;
+        }
+        if (end_us - now_us < GSYSTEM_YIELD_MIN_US) {
+            system_delay_us(end_us - now_us);
+            break;
+        }
+        sys_post_drain();
+        sys_twheel_tick();
+        scheduler.yield();
+    }
+    yielding = false;
+}
+
+extern "C" void system_yield_delay_ms(uint32_t ms)
+{
+    system_yield_delay_us((uint64_t)ms * MILLIS_US);
+}
+
+extern "C" uint8_t sys_running_job_id()
+{
+    return scheduler.running_id();
+}
+
+extern "C" void system_idle()
+{
+    scheduler.idle();
 }
 
 extern "C" void system_tick_isr()
 {
-    scheduler.tick(true);
+    scheduler.tick_isr();
+}
+
+#if defined(GSYSTEM_ISR_TIMER)
+void _scheduler_isr_callback()
+{
+    scheduler.tick_isr();
 }
+#endif
 
-extern "C" void system_register(void (*task) (void), uint32_t delay_ms, bool realtime, bool work_with_error, uint32_t priority)
+extern "C" gsys_job_t system_register(void (*task) (void), uint32_t delay_ms, bool realtime, bool work_with_error, uint32_t priority)
 {
     if (!task) {
         BEDUG_ASSERT(false, "Empty task");
-        return;
+        return GSYS_JOB_INVALID;
     }
     if (scheduler.full()) {
         BEDUG_ASSERT(false, "GSystem user jobs is out of range");
-        return;
+        return GSYS_JOB_INVALID;
+    }
+    JobDesc desc = {task, delay_ms, realtime, work_with_error};
+	Job job(delay_ms, (uint8_t)priority, false);
+    Job* added = scheduler.add_task(&job, desc);
+    if (added) {
+        SYSTEM_BEDUG("add job[%02u] (addr=0x%08X delay_ms=%lu)", added->id, task, delay_ms);
+    }
+    return Scheduler::job_handle(added);
+}
+
+extern "C" bool system_job_suspend(gsys_job_t handle)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job) {
+        return false;
+    }
+    scheduler.suspend(job);
+    return true;
+}
+
+extern "C" bool system_job_resume(gsys_job_t handle)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job) {
+        return false;
+    }
+    scheduler.resume(job);
+    return true;
+}
+
+extern "C" bool system_job_remove(gsys_job_t handle)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job) {
+        return false;
+    }
+    SYSTEM_BEDUG("remove job[%02u] (addr=0x%08X)", job->id, job->action());
+    scheduler.remove(job);
+    return true;
+}
+
+extern "C" bool system_job_set_period(gsys_job_t handle, uint32_t period_ms)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job || !period_ms) {
+        return false;
+    }
+    return scheduler.set_period(job, period_ms);
+}
+
+extern "C" bool system_job_set_priority(gsys_job_t handle, uint32_t priority)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job) {
+        return false;
+    }
+    scheduler.set_priority(job, priority);
+    return true;
+}
+
+extern "C" bool system_job_is_suspended(gsys_job_t handle)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    return job && job->suspended;
+}
+
+extern "C" bool system_job_set_phase(gsys_job_t handle, uint32_t phase_ms)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job) {
+        return false;
+    }
+    return scheduler.set_phase(job, phase_ms);
+}
+
+extern "C" gsys_job_t system_register_rt(void (*task) (void), uint32_t period_ms, uint32_t wcet_us, uint32_t deadline_ms, bool work_with_error)
+{
+#if defined(GSYSTEM_SCHEDULER_EDF)
+    if (!task || !period_ms || !wcet_us) {
+        BEDUG_ASSERT(false, "Empty task or its period or WCET");
+        return GSYS_JOB_INVALID;
+    }
+    if (!deadline_ms) {
+        deadline_ms = period_ms;
     }
-	Job job(task, delay_ms, realtime, work_with_error, (uint8_t)priority, false);
-    SYSTEM_BEDUG("add job[%02u] (addr=0x%08X delay_ms=%lu)", scheduler.job_count(), task, delay_ms);
-    scheduler.add_task(&job);
+    JobDesc desc = {task, period_ms, true, work_with_error};
+	Job job(period_ms, GSYSTEM_PROCCESS_PRIORITY_DEFAULT, false);
+    job.edf         = true;
+    job.wcet_us     = wcet_us;
+    job.deadline_us = deadline_ms * MILLIS_US;
+    Job* added = scheduler.add_rt_task(&job, desc);
+    if (!added) {
+        SYSTEM_BEDUG("EDF job is not schedulable (addr=0x%08X period_ms=%lu wcet_us=%lu deadline_ms=%lu)", task, period_ms, wcet_us, deadline_ms);
+        return GSYS_JOB_INVALID;
+    }
+    SYSTEM_BEDUG("add EDF job[%02u] (addr=0x%08X period_ms=%lu wcet_us=%lu deadline_ms=%lu)", added->id, task, period_ms, wcet_us, deadline_ms);
+    return Scheduler::job_handle(added);
+#else
+    (void)task;
+    (void)period_ms;
+    (void)wcet_us;
+    (void)deadline_ms;
+    (void)work_with_error;
+    BEDUG_ASSERT(false, "GSYSTEM_SCHEDULER_EDF is disabled");
+    return GSYS_JOB_INVALID;
+#endif
 }
 
-void system_register_isr(void (*task) (void), uint32_t delay_ms, bool realtime, bool work_with_error, uint32_t priority)
+extern "C" gsys_job_t system_register_isr(void (*task) (void), uint32_t delay_ms, bool realtime, bool work_with_error, uint32_t priority)
 {
     if (!task) {
         BEDUG_ASSERT(false, "Empty task");
-        return;
+        return GSYS_JOB_INVALID;
+    }
+    if (!delay_ms) {
+        BEDUG_ASSERT(false, "Empty ISR task period");
+        return GSYS_JOB_INVALID;
+    }
+    if (scheduler.full()) {
+        BEDUG_ASSERT(false, "GSystem user jobs is out of range");
+        return GSYS_JOB_INVALID;
+    }
+    JobDesc desc = {task, delay_ms, realtime, work_with_error};
+	Job job(delay_ms, (uint8_t)priority, true);
+    return Scheduler::job_handle(scheduler.add_task(&job, desc));
+}
+
+extern "C" gsys_job_t system_register_isr_us(void (*task) (void), uint32_t period_us, bool work_with_error)
+{
+    if (!task) {
+        BEDUG_ASSERT(false, "Empty task");
+        return GSYS_JOB_INVALID;
+    }
+    if (!period_us) {
+        BEDUG_ASSERT(false, "Empty ISR task period");
+        return GSYS_JOB_INVALID;
     }
     if (scheduler.full()) {
         BEDUG_ASSERT(false, "GSystem user jobs is out of range");
+        return GSYS_JOB_INVALID;
+    }
+    // The ISR tier runs on period_us, the millisecond period of the descriptor
+    // and the stats is rounded up (1 ms for the sub-millisecond periods)
+    uint32_t period_ms = period_us / MILLIS_US + (period_us % MILLIS_US ? 1 : 0);
+    JobDesc desc = {task, period_ms, true, work_with_error};
+	Job job(period_ms, GSYSTEM_PROCCESS_PRIORITY_DEFAULT, true);
+    job.period_us = period_us;
+    return Scheduler::job_handle(scheduler.add_task(&job, desc));
+}
+
+extern "C" bool system_job_latency(gsys_job_t handle, gsys_job_latency_t* latency)
+{
+#if defined(GSYSTEM_PROC_HISTOGRAM)
+    Job* job = scheduler.job_by_handle(handle);
+    if (!latency || !job) {
+        return false;
+    }
+    JobStats& stats = job->stats();
+    latency->exec_p50_us    = stats.exec_hist.percentile_us(500);
+    latency->exec_p99_us    = stats.exec_hist.percentile_us(990);
+    latency->exec_p999_us   = stats.exec_hist.percentile_us(999);
+    latency->jitter_p50_us  = stats.jitter_hist.percentile_us(500);
+    latency->jitter_p99_us  = stats.jitter_hist.percentile_us(990);
+    latency->jitter_p999_us = stats.jitter_hist.percentile_us(999);
+    return true;
+#else
+    (void)handle;
+    (void)latency;
+    return false;
+#endif
+}
+
+extern "C" void system_job_latency_reset(gsys_job_t handle)
+{
+#if defined(GSYSTEM_PROC_HISTOGRAM)
+    Job* job = scheduler.job_by_handle(handle);
+    if (!job) {
         return;
     }
-	Job job(task, delay_ms, realtime, work_with_error, (uint8_t)priority, true);
-    scheduler.add_task(&job);
+    job->stats().exec_hist.reset();
+    job->stats().jitter_hist.reset();
+#else
+    (void)handle;
+#endif
+}
+
+extern "C" bool system_get_job_stats(gsys_job_t handle, gsys_job_stats_t* stats)
+{
+    Job* job = scheduler.job_by_handle(handle);
+    if (!stats || !job) {
+        return false;
+    }
+    scheduler.job_stats(job, stats);
+    return true;
+}
+
+extern "C" bool system_get_scheduler_stats(gsys_scheduler_stats_t* stats)
+{
+    if (!stats) {
+        return false;
+    }
+    scheduler.scheduler_stats(stats);
+    return true;
+}
+
+/*
+ * Binary snapshot layout (little endian, packed):
+ *   header : magic "GSTS", u16 version, u16 jobs, snapshot_scheduler_t
+ *   jobs   : jobs x snapshot_job_t
+ */
+typedef struct __attribute__((packed)) _snapshot_scheduler_t {
+    uint16_t total_load_x100;
+    uint16_t isr_load_x100;
+    uint16_t target_load_x100;
+    uint32_t jobs_scale_x100;
+    uint32_t ticks_per_second;
+    uint32_t isr_budget_hits;
+} snapshot_scheduler_t;
+
+typedef struct __attribute__((packed)) _snapshot_job_t {
+    uint32_t action;
+    uint32_t period_us;
+    uint32_t effective_period_ms;
+    uint16_t load_x100;
+    uint32_t average_us;
+    uint32_t max_exec_us;
+    uint32_t exec_counter;
+    uint32_t scale_x100;
+    uint32_t overruns;
+    uint32_t deadline_misses;
+    uint8_t  priority;
+    uint8_t  flags;       // bit 0 - realtime, bit 1 - ISR
+} snapshot_job_t;
+
+static constexpr uint32_t SNAPSHOT_MAGIC   = 0x53545347; // "GSTS"
+static constexpr uint16_t SNAPSHOT_VERSION = 2;
+
+extern "C" uint32_t system_stats_snapshot(uint8_t* buf, uint32_t size)
+{
+    uint32_t jobs_cnt = scheduler.job_count();
+    uint32_t need = (uint32_t)(sizeof(uint32_t) + 2 * sizeof(uint16_t) + sizeof(snapshot_scheduler_t) + jobs_cnt * sizeof(snapshot_job_t));
+    if (!buf) {
+        return need;
+    }
+    if (size < need) {
+        return 0;
+    }
+
+    uint8_t* ptr = buf;
+    auto put = [&ptr] (const void* data, uint32_t len) {
+        memcpy(ptr, data, len);
+        ptr += len;
+    };
+
+    gsys_scheduler_stats_t sched = {};
+    scheduler.scheduler_stats(&sched);
+    snapshot_scheduler_t sched_rec = {
+        (uint16_t)__min(sched.total_load_x100, (uint32_t)0xFFFF),
+        (uint16_t)__min(sched.isr_load_x100, (uint32_t)0xFFFF),
+        (uint16_t)sched.target_load_x100,
+        sched.jobs_scale_x100,
+        sched.ticks_per_second,
+        sched.isr_budget_hits
+    };
+    uint16_t version = SNAPSHOT_VERSION;
+    uint16_t count   = (uint16_t)jobs_cnt;
+    put(&SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    put(&version, sizeof(version));
+    put(&count, sizeof(count));
+    put(&sched_rec, sizeof(sched_rec));
+
+    for (uint32_t i = 0; i < jobs_cnt; i++) {
+        // Removed jobs slots are kept with the zero action to keep the job ids
+        gsys_job_stats_t stats = {};
+        Job* job = scheduler.job_at(i);
+        if (job) {
+            scheduler.job_stats(job, &stats);
+        }
+        snapshot_job_t job_rec = {
+            stats.action,
+            stats.period_us,
+            stats.effective_period_ms,
+            (uint16_t)__min(stats.load_x100, (uint32_t)0xFFFF),
+            stats.average_us,
+            stats.max_exec_us,
+            stats.exec_counter,
+            stats.scale_x100,
+            stats.overruns,
+            stats.deadline_misses,
+            stats.priority,
+            (uint8_t)((stats.realtime ? 0x01 : 0) | (stats.isr ? 0x02 : 0))
+        };
+        put(&job_rec, sizeof(job_rec));
+    }
+
+    return (uint32_t)(ptr - buf);
+}
+
+extern "C" uint32_t sys_jobs_count()
+{
+    return scheduler.job_count();
+}
+
+extern "C" uint64_t sys_jobs_next_us()
+{
+    return scheduler.next_launch_us();
+}
+
+extern "C" void sys_trace_dump_jobs(void (*write)(const uint8_t*, uint32_t))
+{
+    for (uint32_t i = 0; i < scheduler.job_count(); i++) {
+        Job* job = scheduler.job_at(i);
+        uint32_t info[2] = {
+            job ? (uint32_t)(uintptr_t)job->action() : 0,
+            job ? (job->isr ? job->period_us : job->current_delay_ms * MILLIS_US) : 0
+        };
+        write((const uint8_t*)info, sizeof(info));
+    }
 }
 
 extern "C" void set_system_timeout(uint32_t timeout_ms)
@@ -7,6 +7,7 @@
 
 #include "glog.h"
 #include "gsystem.h"
+#include "gcoroutine.h"
 
 
 #ifndef GSYSTEM_NO_RTC_W
@@ -21,6 +22,9 @@ extern "C" bool __internal_get_clock_ram(const uint8_t idx, uint8_t* data);
 extern "C" bool __internal_set_clock_ram(const uint8_t idx, uint8_t data);
 
 
+static constexpr uint32_t RTC_START_TIMEOUT_MS = 15 * SECOND_MS;
+
+
 void _print_OK()
 {
 #if GSYSTEM_BEDUG
@@ -28,11 +32,18 @@ void _print_OK()
 #endif
 }
 
+static bool _rtc_start()
+{
+	if (!is_clock_started()) {
+		clock_begin();
+	}
+	return is_clock_started();
+}
+
 extern "C" void rtc_watchdog_check()
 {
+	static gsys_coro_t coro = {};
 	static bool system_error_loaded = false;
-	static bool start_timer_flag = false;
-	static gtimer_t timer = {};
 	static bool tested = false;
 
     #ifndef GSYSTEM_NO_RTC_CALENDAR_W
@@ -106,20 +117,12 @@ extern "C" void rtc_watchdog_check()
 	uint8_t  ram_bckp[sizeof(uint32_t)] = {};
 	uint32_t ram_word = 0x12345678;
 	uint32_t ram_word_check = 0;
+	uint8_t  ram_dump = 0;
 
 	if (!is_system_ready() && !is_error(RTC_ERROR)) {
 		return;
 	}
 
-	if (!start_timer_flag) {
-		gtimer_start(&timer, 15 * SECOND_MS);
-		start_timer_flag = true;
-	}
-
-	if (!is_clock_started()) {
-		clock_begin();
-	}
-
 	#if defined(GSYSTEM_DOUBLE_BKCP_ENABLE)
 	static bool __intenal_system_error_loaded = false;
     if (!__internal_is_clock_ready()) {
@@ -139,10 +142,19 @@ extern "C" void rtc_watchdog_check()
 		set_last_error((SOUL_STATUS)status);
 		__intenal_system_error_loaded = true;
 
-		SYSTEM_BEDUG("Last reload error (internal backup): %s", get_status_name(get_last_error()));
+		SYSTEM_BEDUG("Last reload error (internal backup): " SOUL_STATUS_FMT, SOUL_STATUS_ARG(get_last_error()));
 	}
 	#endif
-	if (is_clock_started() && !system_error_loaded) {
+
+	// The launches resume at the clock start await: it passes at once when the clock runs
+	GSYS_CORO_BEGIN(&coro);
+	GSYS_CORO_AWAIT_TIMEOUT(&coro, _rtc_start(), RTC_START_TIMEOUT_MS);
+	if (!is_clock_started()) {
+		set_error(RTC_ERROR);
+		GSYS_CORO_AWAIT(&coro, _rtc_start());
+	}
+
+	if (!system_error_loaded) {
 		SOUL_STATUS status = (SOUL_STATUS)0;
 		for (uint8_t i = 0; i < sizeof(status); i++) {
 			if (!get_clock_ram(i, &((uint8_t*)&status)[i])) {
@@ -156,14 +168,7 @@ extern "C" void rtc_watchdog_check()
 		set_last_error((SOUL_STATUS)status);
 		system_error_loaded = true;
 
-		SYSTEM_BEDUG("Last reload error (external backup): %s", get_status_name(get_last_error()));
-	}
-
-	if (!is_clock_started()) {
-		if (!gtimer_wait(&timer)) {
-			set_error(RTC_ERROR);
-		}
-		return;
+		SYSTEM_BEDUG("Last reload error (external backup): " SOUL_STATUS_FMT, SOUL_STATUS_ARG(get_last_error()));
 	}
 
 	if (!is_status(RTC_READY)) {
@@ -184,7 +189,6 @@ extern "C" void rtc_watchdog_check()
 
 	SYSTEM_BEDUG("RTC testing in progress...");
 
-	uint8_t ram_dump = 0;
 	if (!get_clock_ram(0, &ram_dump)) {
 		goto do_error;
 	}
@@ -376,6 +380,8 @@ do_error:
 	set_error(RTC_ERROR);
 	return;
     #endif
+
+	GSYS_CORO_END(&coro);
 }
     #undef RTC_ERROR_END
 #endif
@@ -0,0 +1,248 @@
+/*
+ * @file g_soul_log.cpp
+ * @brief Soul flight recorder: status and error transition history (GSYSTEM_SOUL_LOG).
+ *
+ * Every soul status or error change is appended by soul.c as an 8-byte
+ * record (timestamp, status, set/reset, boot counter, check) into a ring
+ * in the .noinit RAM section, so the history survives warm resets
+ * (watchdog, error handler reboot, hard fault). The ring header is
+ * protected by a canary and a hash, every record has its own check, so a
+ * record torn by the reset is dropped on recovery.
+ *
+ * Appends are lock-free and allowed from interrupt handlers, the memory is
+ * written only by the background soul_log_flush() system job: full chunks
+ * of the current boot and the tail recovered after a reset are stored as
+ * StorageAT records ("SLG" prefix, GSYSTEM_SOUL_LOG_CHUNKS rotating indexes).
+ *
+ * The linker script must place .noinit into RAM as NOLOAD, see
+ * test/stm32_example/STM32F103C8TX_FLASH.ld.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "glog.h"
+#include "soul.h"
+#include "gutils.h"
+#include "gsystem.h"
+#include "drivers.h"
+
+
+#if defined(GSYSTEM_SOUL_LOG)
+
+
+#if !defined(GSYSTEM_NO_MEMORY_W) && !defined(GSYSTEM_NO_STORAGE_AT)
+    #include "StorageAT.h"
+    #define SOUL_LOG_STORAGE
+extern StorageAT storage;
+#endif
+
+
+static_assert(
+    GSYSTEM_SOUL_LOG_SIZE && !(GSYSTEM_SOUL_LOG_SIZE & (GSYSTEM_SOUL_LOG_SIZE - 1)),
+    "GSYSTEM_SOUL_LOG_SIZE must be a power of 2"
+);
+static_assert(SOUL_STATUSES_END <= 0xFF, "Soul log records store 8-bit statuses");
+static_assert(sizeof(gsys_soul_record_t) == 8, "Soul log record must be 8 bytes");
+
+
+static constexpr uint32_t SOUL_LOG_CANARY = 0x534C4F47; // "SLOG"
+static constexpr uint32_t SOUL_LOG_MASK   = GSYSTEM_SOUL_LOG_SIZE - 1;
+static constexpr uint32_t SOUL_LOG_CHUNK  = 16;          // Records per memory write
+static constexpr uint8_t  SOUL_LOG_SET    = 0x01;
+
+static_assert(GSYSTEM_SOUL_LOG_SIZE >= SOUL_LOG_CHUNK, "GSYSTEM_SOUL_LOG_SIZE must be at least 16");
+
+
+/*
+ * Ring state kept over warm resets: nothing here is initialized by the
+ * startup code, the header is validated by sys_soul_log_init().
+ */
+struct SoulLog {
+    uint32_t              canary;
+    uint32_t              boot;      // Warm resets since the last power on
+    uint32_t              flushed;   // Records stored to the memory
+    uint32_t              flush_seq; // Memory chunks written
+    uint32_t              hash;      // Hash of the fields above
+    volatile uint32_t     head;      // Records appended
+    gsys_soul_record_t    records[GSYSTEM_SOUL_LOG_SIZE];
+};
+
+/* Memory chunk layout: the first record index, the records count and the records */
+struct SoulLogChunk {
+    uint32_t           first;
+    uint32_t           count;
+    gsys_soul_record_t records[SOUL_LOG_CHUNK];
+};
+
+
+__attribute__((section(".noinit"))) static SoulLog soul_log;
+
+static uint32_t soul_log_boot_head = 0; // The first record of the current boot
+
+
+static uint32_t _header_hash()
+{
+    return util_hash((const uint8_t*)&soul_log, offsetof(SoulLog, hash));
+}
+
+static uint16_t _record_check(const gsys_soul_record_t* record)
+{
+    return (uint16_t)(util_hash((const uint8_t*)record, offsetof(gsys_soul_record_t, check)) & 0xFFFF);
+}
+
+static void _header_update()
+{
+    soul_log.hash = _header_hash();
+}
+
+/*
+ * @brief Recover the ring after a warm reset or reset it after a power on.
+ *        Called once by system_init() before the interrupts are started.
+ */
+extern "C" void sys_soul_log_init()
+{
+    uint32_t head = g_atomic_load(&soul_log.head);
+    if (soul_log.canary == SOUL_LOG_CANARY &&
+        soul_log.hash == _header_hash() &&
+        head - soul_log.flushed <= 0x7FFFFFFF
+    ) {
+        soul_log.boot++;
+    } else {
+        soul_log.canary    = SOUL_LOG_CANARY;
+        soul_log.boot      = 0;
+        soul_log.flushed   = 0;
+        soul_log.flush_seq = 0;
+        head               = 0;
+        g_atomic_store(&soul_log.head, 0);
+        memset(soul_log.records, 0, sizeof(soul_log.records));
+    }
+    soul_log_boot_head = head;
+    _header_update();
+}
+
+extern "C" void sys_soul_log_append(SOUL_STATUS status, bool set)
+{
+    uint32_t index = g_atomic_fetch_add(&soul_log.head, 1);
+    gsys_soul_record_t* record = &soul_log.records[index & SOUL_LOG_MASK];
+    record->check   = 0;
+    record->time_ms = system_millis();
+    record->status  = (uint8_t)status;
+    record->flags   = (uint8_t)((set ? SOUL_LOG_SET : 0) | ((soul_log.boot & 0x7F) << 1));
+    __atomic_signal_fence(__ATOMIC_RELEASE);
+    record->check   = _record_check(record);
+}
+
+extern "C" uint32_t system_soul_log_count(void)
+{
+    uint32_t head = g_atomic_load(&soul_log.head);
+    return head < GSYSTEM_SOUL_LOG_SIZE ? head : GSYSTEM_SOUL_LOG_SIZE;
+}
+
+extern "C" bool system_soul_log_get(uint32_t index, gsys_soul_record_t* record)
+{
+    if (!record || index >= system_soul_log_count()) {
+        return false;
+    }
+    uint32_t head = g_atomic_load(&soul_log.head);
+    *record = soul_log.records[(head - 1 - index) & SOUL_LOG_MASK];
+    return record->check == _record_check(record);
+}
+
+#if defined(SOUL_LOG_STORAGE)
+static bool _soul_log_store(const SoulLogChunk* chunk)
+{
+    static const char PREFIX[] = "SLG";
+
+    uint32_t index   = soul_log.flush_seq % GSYSTEM_SOUL_LOG_CHUNKS + 1;
+    uint32_t address = 0;
+    StorageStatus status = storage.find(FIND_MODE_EQUAL, &address, PREFIX, index);
+    if (status == STORAGE_NOT_FOUND) {
+        status = storage.find(FIND_MODE_EMPTY, &address);
+    }
+    if (status != STORAGE_OK) {
+        SYSTEM_BEDUG("soul log: find err=%02X", status);
+        return false;
+    }
+    status = storage.rewrite(address, PREFIX, index, (uint8_t*)chunk, sizeof(*chunk));
+    if (status != STORAGE_OK) {
+        SYSTEM_BEDUG("soul log: save err=%02X addr=%lu", status, address);
+        return false;
+    }
+    return true;
+}
+
+extern "C" void soul_log_flush()
+{
+    uint32_t head = g_atomic_load(&soul_log.head);
+    if (head - soul_log.flushed > GSYSTEM_SOUL_LOG_SIZE) {
+        // The ring has overwritten the records that were not stored
+        soul_log.flushed = head - GSYSTEM_SOUL_LOG_SIZE;
+        _header_update();
+    }
+
+    // Records of the current boot are stored in full chunks only
+    uint32_t pending = head - soul_log.flushed;
+    if (soul_log.flushed >= soul_log_boot_head && pending < SOUL_LOG_CHUNK) {
+        return;
+    }
+    if (soul_log.flushed < soul_log_boot_head) {
+        pending = __min(pending, soul_log_boot_head - soul_log.flushed);
+    }
+
+    if (!is_status(MEMORY_INITIALIZED) || is_status(MEMORY_WRITE_FAULT) || is_error(MEMORY_ERROR)) {
+        return;
+    }
+
+    SoulLogChunk chunk = {};
+    chunk.first = soul_log.flushed;
+    chunk.count = __min(pending, SOUL_LOG_CHUNK);
+    for (uint32_t i = 0; i < chunk.count; i++) {
+        uint32_t index = chunk.first + i;
+        chunk.records[i] = soul_log.records[index & SOUL_LOG_MASK];
+        if (chunk.records[i].check == _record_check(&chunk.records[i])) {
+            continue;
+        }
+        if (index >= soul_log_boot_head) {
+            // An interrupt handler is writing the record right now
+            return;
+        }
+        // Torn by the reset
+        memset(&chunk.records[i], 0, sizeof(chunk.records[i]));
+    }
+
+    if (!_soul_log_store(&chunk)) {
+        return;
+    }
+    soul_log.flush_seq++;
+    soul_log.flushed += chunk.count;
+    _header_update();
+}
+#endif
+
+
+#else
+
+
+extern "C" void sys_soul_log_init() {}
+
+extern "C" void sys_soul_log_append(SOUL_STATUS, bool) {}
+
+extern "C" uint32_t system_soul_log_count(void)
+{
+    return 0;
+}
+
+extern "C" bool system_soul_log_get(uint32_t, gsys_soul_record_t*)
+{
+    return false;
+}
+
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * @file g_timer.cpp
+ * @brief Polled software timers (system_timer_t) on the 32-bit millisecond time.
+ *
+ * The elapsed time is computed in modular arithmetic, so a timer started
+ * before the 32-bit millisecond counter wrap (~49.7 days) expires on time
+ * after it. Delays must be shorter than the wrap period.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdint>
+
+#include "glog.h"
+#include "gutils.h"
+#include "gsystem.h"
+#include "drivers.h"
+
+
+extern "C" void system_timer_start(system_timer_t* timer, uint32_t delay_ms)
+{
+    if (!timer) {
+        BEDUG_ASSERT(false, "Timer must not be NULL");
+        return;
+    }
+    timer->started  = true;
+    timer->delay_ms = delay_ms;
+    timer->start_ms = system_millis();
+}
+
+extern "C" bool system_timer_wait(const system_timer_t* timer)
+{
+    if (!timer) {
+        BEDUG_ASSERT(false, "Timer must not be NULL");
+        return false;
+    }
+    return timer->started && (uint32_t)(system_millis() - timer->start_ms) > timer->delay_ms;
+}
+
+extern "C" void system_timer_stop(system_timer_t* timer)
+{
+    if (!timer) {
+        BEDUG_ASSERT(false, "Timer must not be NULL");
+        return;
+    }
+    timer->started = false;
+}
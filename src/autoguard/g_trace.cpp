@@ -0,0 +1,156 @@
+/*
+ * @file g_trace.cpp
+ * @brief Binary scheduler trace recorder (GSYSTEM_TRACE).
+ *
+ * The scheduler writes one 12-byte record per job launch or denied launch
+ * into a RAM ring buffer. system_trace_dump() streams the ring with a
+ * header and the job table through a writer (debug UART by default), the
+ * dump is converted to Chrome trace JSON by tools/gtrace2chrome.py.
+ *
+ * Dump layout (little endian):
+ *   header  : magic "GTRC", u16 version, u16 record size, u32 records, u32 jobs
+ *   jobs    : jobs x { u32 action address, u32 period us }
+ *   records : records x gsys_trace_record_t, the oldest first
+ *
+ * Records are written by the main loop and by the interrupt handlers, so
+ * each one carries the sequence number of its ring position: the dump
+ * copies a record only if the sequence matches before and after the copy,
+ * torn or overwritten records are dumped with the TRACE_JOB_LOST job id.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdint>
+
+#include "gsystem.h"
+#include "drivers.h"
+
+
+#if defined(GSYSTEM_TRACE)
+
+
+static_assert(
+    GSYSTEM_TRACE_SIZE && !(GSYSTEM_TRACE_SIZE & (GSYSTEM_TRACE_SIZE - 1)),
+    "GSYSTEM_TRACE_SIZE must be a power of 2"
+);
+
+
+typedef struct _gsys_trace_record_t {
+    uint32_t start_us;    // Launch time (low 32 bits of system_micros())
+    uint32_t duration_us; // Execution time
+    uint8_t  job_id;      // Job index in the scheduler table
+    uint8_t  flags;       // bit 0 - ISR tier, bits 1..2 - deny reason (1 - error handler, 2 - MCU error)
+    uint16_t seq;         // Ring position sequence, TRACE_SEQ_BUSY while the record is written
+} gsys_trace_record_t;
+
+static_assert(sizeof(gsys_trace_record_t) == 12, "Trace record size error");
+
+
+static constexpr uint32_t TRACE_MAGIC   = 0x43525447; // "GTRC"
+static constexpr uint16_t TRACE_VERSION = 2;
+static constexpr uint32_t TRACE_MASK    = GSYSTEM_TRACE_SIZE - 1;
+static constexpr uint16_t TRACE_SEQ_BUSY = 0;
+static constexpr uint8_t  TRACE_JOB_LOST = 0xFF;
+
+static gsys_trace_record_t trace_buf[GSYSTEM_TRACE_SIZE] = {};
+static volatile uint32_t trace_head = 0;
+static volatile bool trace_paused = false;
+
+
+/* @brief Sequence of the ring position: 1..0xFFFF, differs for the positions of the nearest 0xFFFF laps */
+static uint16_t _trace_seq(uint32_t index)
+{
+    return (uint16_t)(index % 0xFFFF + 1);
+}
+
+static void _trace_uart_write(const uint8_t* data, uint32_t len)
+{
+    while (len) {
+        uint16_t part = (uint16_t)__min(len, (uint32_t)0xFFFF);
+        g_uart_print((const char*)data, part);
+        data += part;
+        len  -= part;
+    }
+}
+
+extern "C" void sys_trace_record(uint8_t job_id, uint64_t start_us, uint32_t duration_us, uint8_t flags)
+{
+    if (trace_paused) {
+        return;
+    }
+    uint32_t index = g_atomic_fetch_add(&trace_head, 1);
+    gsys_trace_record_t* record = &trace_buf[index & TRACE_MASK];
+    __atomic_store_n(&record->seq, TRACE_SEQ_BUSY, __ATOMIC_RELAXED);
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    record->start_us    = (uint32_t)start_us;
+    record->duration_us = duration_us;
+    record->job_id      = job_id;
+    record->flags       = flags;
+    __atomic_store_n(&record->seq, _trace_seq(index), __ATOMIC_RELEASE);
+}
+
+extern "C" uint32_t sys_jobs_count();
+extern "C" void sys_trace_dump_jobs(void (*write)(const uint8_t*, uint32_t));
+
+extern "C" void system_trace_dump(void (*write)(const uint8_t* data, uint32_t len))
+{
+    if (!write) {
+        write = _trace_uart_write;
+    }
+
+    trace_paused = true;
+
+    uint32_t head  = g_atomic_load(&trace_head);
+    uint32_t count = __min(head, (uint32_t)GSYSTEM_TRACE_SIZE);
+    uint32_t jobs  = sys_jobs_count();
+
+    uint32_t header[4] = {
+        TRACE_MAGIC,
+        (uint32_t)TRACE_VERSION | ((uint32_t)sizeof(gsys_trace_record_t) << 16),
+        count,
+        jobs
+    };
+    write((const uint8_t*)header, sizeof(header));
+
+    sys_trace_dump_jobs(write);
+
+    uint32_t first = head - count;
+    for (uint32_t i = 0; i < count; i++) {
+        const gsys_trace_record_t* slot = &trace_buf[(first + i) & TRACE_MASK];
+        uint16_t seq = _trace_seq(first + i);
+
+        gsys_trace_record_t record = {};
+        bool valid = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == seq;
+        if (valid) {
+            record = *slot;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            valid = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq;
+        }
+        if (!valid) {
+            record        = {};
+            record.job_id = TRACE_JOB_LOST;
+        }
+        write((const uint8_t*)&record, sizeof(record));
+    }
+
+    trace_paused = false;
+}
+
+extern "C" void system_trace_clear(void)
+{
+    g_atomic_store(&trace_head, 0);
+}
+
+
+#else
+
+
+extern "C" void system_trace_dump(void (*)(const uint8_t*, uint32_t)) {}
+
+extern "C" void system_trace_clear(void) {}
+
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * @file g_twheel.cpp
+ * @brief Hierarchical timing wheel for callback soft timers (GSYSTEM_TIMER_WHEEL).
+ *
+ * Timers are caller-owned gsys_wtimer_t nodes linked into the wheel slots,
+ * so the number of timers is not limited by a pool. Start and stop are O(1):
+ * a timer is linked into the slot of the level that covers its delay and
+ * unlinked through its back pointer. system_tick() advances the wheel one
+ * millisecond at a time, the upper level slots are cascaded into the lower
+ * levels when the lower level wraps (Varghese & Lauck scheme 6). Empty level
+ * 0 slots are skipped at once up to the next cascade boundary (the level 0
+ * occupancy bitmap).
+ *
+ * Levels : WHEEL_LEVELS x WHEEL_SLOTS slot heads (640 bytes of RAM),
+ *          level N slot covers 32^N ms, the wheel covers 2^25 ms (~9.3 hours).
+ *          Longer delays wait in the last slot and are re-cascaded.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdint>
+
+#include "glog.h"
+#include "gsystem.h"
+#include "drivers.h"
+
+
+#if defined(GSYSTEM_TIMER_WHEEL)
+
+
+static constexpr uint32_t WHEEL_BITS   = 5;
+static constexpr uint32_t WHEEL_SLOTS  = 1 << WHEEL_BITS;
+static constexpr uint32_t WHEEL_MASK   = WHEEL_SLOTS - 1;
+static constexpr uint32_t WHEEL_LEVELS = 5;
+static constexpr uint64_t WHEEL_RANGE  = 1ULL << (WHEEL_BITS * WHEEL_LEVELS);
+
+
+static gsys_wtimer_t* wheel[WHEEL_LEVELS][WHEEL_SLOTS] = {};
+static uint64_t       wheel_next_ms = 0; // Next millisecond to process
+static uint32_t       wheel_active  = 0;
+static uint32_t       wheel_used    = 0; // Non-empty level 0 slots
+
+static_assert(WHEEL_SLOTS <= 32, "The level 0 occupancy bitmap is 32-bit");
+
+
+/* @brief Level 0 slot index of the slot head, WHEEL_SLOTS for the other lists */
+static uint32_t _wheel_level0_index(gsys_wtimer_t** head)
+{
+    uintptr_t offset = (uintptr_t)head - (uintptr_t)&wheel[0][0];
+    return offset < sizeof(wheel[0]) ? (uint32_t)(offset / sizeof(wheel[0][0])) : WHEEL_SLOTS;
+}
+
+
+static void _wheel_link(gsys_wtimer_t** head, gsys_wtimer_t* timer)
+{
+    uint32_t index = _wheel_level0_index(head);
+    if (index < WHEEL_SLOTS) {
+        wheel_used |= (uint32_t)(1U << index);
+    }
+    timer->next = *head;
+    if (timer->next) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head        = timer;
+}
+
+static void _wheel_unlink(gsys_wtimer_t* timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = timer->pprev;
+    } else {
+        uint32_t index = _wheel_level0_index(timer->pprev);
+        if (index < WHEEL_SLOTS) {
+            wheel_used &= ~(uint32_t)(1U << index);
+        }
+    }
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
+
+static void _wheel_insert(gsys_wtimer_t* timer)
+{
+    uint64_t expire_ms = __max(timer->expire_ms, wheel_next_ms);
+    uint64_t delta_ms  = expire_ms - wheel_next_ms;
+    if (delta_ms >= WHEEL_RANGE) {
+        expire_ms = wheel_next_ms + WHEEL_RANGE - 1;
+        delta_ms  = WHEEL_RANGE - 1;
+    }
+
+    uint32_t level = 0;
+    while (delta_ms >= (1ULL << (WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    _wheel_link(&wheel[level][(expire_ms >> (WHEEL_BITS * level)) & WHEEL_MASK], timer);
+}
+
+static void _wheel_detach(gsys_wtimer_t** slot, gsys_wtimer_t** list)
+{
+    uint32_t index = _wheel_level0_index(slot);
+    if (index < WHEEL_SLOTS) {
+        wheel_used &= ~(uint32_t)(1U << index);
+    }
+    *list = *slot;
+    *slot = NULL;
+    if (*list) {
+        (*list)->pprev = list;
+    }
+}
+
+static void _wheel_cascade(const uint32_t level, const uint32_t index)
+{
+    gsys_wtimer_t* list = NULL;
+    _wheel_detach(&wheel[level][index], &list);
+    while (list) {
+        gsys_wtimer_t* timer = list;
+        _wheel_unlink(timer);
+        _wheel_insert(timer);
+    }
+}
+
+static void _wheel_step(const uint64_t now_ms)
+{
+    uint32_t index = (uint32_t)(wheel_next_ms & WHEEL_MASK);
+    for (uint32_t level = 1; !index && level < WHEEL_LEVELS; level++) {
+        index = (uint32_t)((wheel_next_ms >> (WHEEL_BITS * level)) & WHEEL_MASK);
+        _wheel_cascade(level, index);
+    }
+
+    // Detached list: callbacks may stop or restart any timer of the list
+    gsys_wtimer_t* list = NULL;
+    _wheel_detach(&wheel[0][wheel_next_ms & WHEEL_MASK], &list);
+    wheel_next_ms++;
+
+    while (list) {
+        gsys_wtimer_t* timer = list;
+        _wheel_unlink(timer);
+        if (timer->period_ms) {
+            timer->expire_ms += timer->period_ms;
+            if (timer->expire_ms <= now_ms) {
+                // Skip the periods missed while the main loop was blocked
+                timer->expire_ms = now_ms + timer->period_ms;
+            }
+            _wheel_insert(timer);
+        } else {
+            wheel_active--;
+        }
+        timer->callback(timer->arg);
+    }
+}
+
+/* @brief Next millisecond to step: the next non-empty level 0 slot or the next cascade boundary */
+static uint64_t _wheel_next_step_ms()
+{
+    uint32_t index = (uint32_t)(wheel_next_ms & WHEEL_MASK);
+    uint32_t used  = wheel_used >> index;
+    if (used) {
+        return wheel_next_ms + (uint32_t)__builtin_ctz(used);
+    }
+    // The boundary itself cascades the upper levels
+    return index ? wheel_next_ms + (WHEEL_SLOTS - index) : wheel_next_ms;
+}
+
+extern "C" void sys_twheel_tick()
+{
+    uint64_t now_ms = system_millis64();
+    while (wheel_active && wheel_next_ms <= now_ms) {
+        wheel_next_ms = _wheel_next_step_ms();
+        if (wheel_next_ms > now_ms) {
+            wheel_next_ms = now_ms + 1;
+            break;
+        }
+        _wheel_step(now_ms);
+    }
+}
+
+extern "C" uint64_t sys_twheel_next_ms()
+{
+    if (!wheel_active) {
+        return UINT64_MAX;
+    }
+    // Only the lowest level is exact, the next cascade is the upper bound
+    return _wheel_next_step_ms();
+}
+
+extern "C" bool system_wtimer_start(
+    gsys_wtimer_t* timer,
+    uint32_t delay_ms,
+    uint32_t period_ms,
+    void (*callback)(void*),
+    void* arg
+) {
+    BEDUG_ASSERT(timer && callback, "Timer wheel: invalid timer");
+    if (!timer || !callback) {
+        return false;
+    }
+
+    if (timer->pprev) {
+        _wheel_unlink(timer);
+    } else {
+        if (!wheel_active) {
+            // The empty wheel does not follow the system time
+            wheel_next_ms = system_millis64();
+        }
+        wheel_active++;
+    }
+
+    timer->expire_ms = system_millis64() + delay_ms;
+    timer->period_ms = period_ms;
+    timer->callback  = callback;
+    timer->arg       = arg;
+    _wheel_insert(timer);
+    return true;
+}
+
+extern "C" void system_wtimer_stop(gsys_wtimer_t* timer)
+{
+    if (!timer || !timer->pprev) {
+        return;
+    }
+    _wheel_unlink(timer);
+    wheel_active--;
+}
+
+extern "C" bool system_wtimer_active(const gsys_wtimer_t* timer)
+{
+    return timer && timer->pprev;
+}
+
+
+#else
+
+
+extern "C" void sys_twheel_tick() {}
+
+extern "C" uint64_t sys_twheel_next_ms()
+{
+    return UINT64_MAX;
+}
+
+extern "C" bool system_wtimer_start(gsys_wtimer_t*, uint32_t, uint32_t, void (*)(void*), void*)
+{
+    return false;
+}
+
+extern "C" void system_wtimer_stop(gsys_wtimer_t*) {}
+
+extern "C" bool system_wtimer_active(const gsys_wtimer_t*)
+{
+    return false;
+}
+
+
+#endif
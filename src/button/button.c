@@ -157,6 +157,7 @@ void _btn_idle_action(button_t* button)
 
 	if (button->_pressed) {
 		SYSTEM_BEDUG("button [0x%08X-0x%02X]: pressed", (unsigned)button->_pin.port, button->_pin.pin);
+		system_event_publish(GSYS_EVENT_BUTTON, GSYS_BUTTON_PRESSED, 0, &button->_pin);
 		gtimer_start(&button->_clicks_tim, GSYSTEM_BUTTON_CLICKS_DELAY_MS);
 	}
 }
@@ -174,9 +175,11 @@ void _btn_pressed_action(button_t* button)
 		button->_next_click = false;
 		button->_clicks++;
 		SYSTEM_BEDUG("button [0x%08X-0x%02X]: clicked (%u times)", (unsigned)button->_pin.port, button->_pin.pin, button->_clicks);
+		system_event_publish(GSYS_EVENT_BUTTON, GSYS_BUTTON_CLICKED, (uint32_t)button->_clicks, &button->_pin);
 	} else if (!gtimer_wait(&button->_held_tim)) {
 		button->_held = true;
 		SYSTEM_BEDUG("button [0x%08X-0x%02X]: held", (unsigned)button->_pin.port, button->_pin.pin);
+		system_event_publish(GSYS_EVENT_BUTTON, GSYS_BUTTON_HELD, 0, &button->_pin);
 	}
 	button->_pressed = pressed;
 }
@@ -186,6 +189,7 @@ void _btn_held_action(button_t* button)
 	button->_pressed = _btn_pressed(button);
 	if (!button->_pressed) {
 		SYSTEM_BEDUG("button [0x%08X-0x%02X]: not held", (unsigned)button->_pin.port, button->_pin.pin);
+		system_event_publish(GSYS_EVENT_BUTTON, GSYS_BUTTON_RELEASED, 0, &button->_pin);
 		gtimer_start(&button->_debounce, button->_debounce_ms);
 		button->_held = false;
 	}
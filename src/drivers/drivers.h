@@ -58,6 +58,180 @@ typedef struct _system_timer_t {
 } system_timer_t;
 
 
+/*
+ * System time in milliseconds: the 32-bit counter (wraps every ~49.7 days)
+ * and the number of its bit 31 transitions. The pair makes a 64-bit time
+ * without locking: the half-period counter is updated after the counter, so
+ * if it is read first it may only lag by one step, the lag is detected by
+ * the counter bit 31.
+ */
+extern volatile uint32_t sys_time_ms;
+extern volatile uint32_t sys_time_ms_half;
+
+/* @brief Advance the system time, called from the system timer interrupt only */
+static inline void g_sys_time_add(uint32_t ms)
+{
+    uint32_t prev = sys_time_ms;
+    sys_time_ms = prev + ms;
+    if ((prev ^ sys_time_ms) & 0x80000000UL) {
+        sys_time_ms_half++;
+    }
+}
+
+/* @brief 64-bit system time from the half-period counter and the counter read after it */
+static inline uint64_t g_sys_time_ms64(uint32_t half, uint32_t ms)
+{
+    if ((half & 0x01) != (ms >> 31)) {
+        half++;
+    }
+    return ((uint64_t)half << 31) | (ms & 0x7FFFFFFFUL);
+}
+
+/* @brief 64-bit system time, the half-period counter is read first */
+static inline uint64_t g_sys_time_read_ms64(void)
+{
+    uint32_t half = sys_time_ms_half;
+    uint32_t ms   = sys_time_ms;
+    return g_sys_time_ms64(half, ms);
+}
+
+#if defined(USE_HAL_DRIVER)
+/*
+ * @brief Microseconds of the system time and the system timer counter without
+ *        masking the interrupts: the pair is read again if the system tick was
+ *        handled in between. An overflow not counted by the tick yet (UIF is
+ *        pending while the counter is in the first half of the period) adds
+ *        one millisecond. The tick interrupt must not be preempted by a reader.
+ */
+static inline uint64_t g_sys_time_us(hard_tim_t* timer)
+{
+    uint32_t ms32;
+    uint32_t half;
+    uint32_t cnt;
+    bool overflow_pending;
+
+    do {
+        half = sys_time_ms_half;
+        ms32 = sys_time_ms;
+        cnt  = timer->CNT;
+        overflow_pending = (timer->SR & TIM_SR_UIF) != 0;
+    } while (ms32 != sys_time_ms);
+
+    uint64_t ms  = g_sys_time_ms64(half, ms32);
+    uint32_t arr = timer->ARR;
+    if (overflow_pending && (cnt < (arr / 2))) {
+        ms++;
+    }
+
+    if (arr == MILLIS_US - 1) {
+        return ms * (uint64_t)MILLIS_US + cnt;
+    }
+    return ms * (uint64_t)MILLIS_US + (uint32_t)(((uint64_t)cnt * MILLIS_US) / (arr + 1));
+}
+#endif
+
+
+/*
+ * Read-modify-write of a word shared with interrupt handlers, returns the
+ * previous value. ARMv6-M has no exclusive access instructions and the
+ * toolchain has no libatomic for the std::atomic read-modify-write calls
+ * there, so the update is done with the interrupts masked for a few cycles.
+ */
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    // An interrupt between LDREX and STREX clears the exclusive monitor
+    #define G_ATOMIC_UPDATE(WORD, PREV, EXPR)                                  \
+        do {                                                                   \
+            __atomic_signal_fence(__ATOMIC_SEQ_CST);                           \
+            do {                                                               \
+                (PREV) = __LDREXW(WORD);                                       \
+            } while (__STREXW((EXPR), (WORD)));                                \
+            __atomic_signal_fence(__ATOMIC_SEQ_CST);                           \
+        } while (0)
+#elif defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+    #define G_ATOMIC_UPDATE(WORD, PREV, EXPR)                                  \
+        do {                                                                   \
+            uint32_t primask_ = __get_PRIMASK();                               \
+            __disable_irq();                                                   \
+            (PREV) = *(WORD);                                                  \
+            *(WORD) = (EXPR);                                                  \
+            __set_PRIMASK(primask_);                                           \
+        } while (0)
+#else
+    #define G_ATOMIC_UPDATE(WORD, PREV, EXPR)                                  \
+        do {                                                                   \
+            (PREV) = __atomic_load_n((WORD), __ATOMIC_RELAXED);                \
+        } while (!__atomic_compare_exchange_n(                                 \
+            (WORD), &(PREV), (EXPR), true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED  \
+        ))
+#endif
+
+static inline uint32_t g_atomic_fetch_add(volatile uint32_t* word, uint32_t value)
+{
+    uint32_t prev;
+    G_ATOMIC_UPDATE(word, prev, prev + value);
+    return prev;
+}
+
+static inline uint32_t g_atomic_fetch_or(volatile uint32_t* word, uint32_t mask)
+{
+    uint32_t prev;
+    G_ATOMIC_UPDATE(word, prev, prev | mask);
+    return prev;
+}
+
+static inline uint32_t g_atomic_fetch_and(volatile uint32_t* word, uint32_t mask)
+{
+    uint32_t prev;
+    G_ATOMIC_UPDATE(word, prev, prev & mask);
+    return prev;
+}
+
+static inline uint32_t g_atomic_exchange(volatile uint32_t* word, uint32_t value)
+{
+    uint32_t prev;
+    G_ATOMIC_UPDATE(word, prev, value);
+    return prev;
+}
+
+/* @brief Store the desired value if the word holds the expected one */
+static inline bool g_atomic_cas(volatile uint32_t* word, uint32_t expected, uint32_t desired)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    do {
+        if (__LDREXW(word) != expected) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(desired, word));
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    return true;
+#elif defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool swapped = *word == expected;
+    if (swapped) {
+        *word = desired;
+    }
+    __set_PRIMASK(primask);
+    return swapped;
+#else
+    return __atomic_compare_exchange_n(word, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+/* @brief Plain word loads and stores are single instructions on every core, these order them */
+static inline uint32_t g_atomic_load(const volatile uint32_t* word)
+{
+    return __atomic_load_n(word, __ATOMIC_ACQUIRE);
+}
+
+static inline void g_atomic_store(volatile uint32_t* word, uint32_t value)
+{
+    __atomic_store_n(word, value, __ATOMIC_RELEASE);
+}
+
+
 /*
  * @brief Trigger a platform reboot/reset.
  * @param None
@@ -85,6 +259,11 @@ void g_uart_print(const char* data, const uint16_t len);
 
 void g_delay_ms(const uint32_t ms);
 
+/*
+ * @brief Busy-wait delay calibrated to the core clock (DWT cycle counter where available).
+ */
+void g_delay_us(const uint32_t us);
+
 uint32_t g_system_freq(void);
 
 uint32_t g_get_millis_hw_tim_presc();
@@ -93,14 +272,61 @@ uint32_t g_get_millis_hw_tim_count();
 
 bool g_sys_tick_start(hard_tim_t* timer);
 
+/*
+ * @brief Stretch the system timer period and sleep (WFI) up to ms milliseconds.
+ *        Must be called with interrupts masked; sys_time_ms is compensated on wake up.
+ * @param ms Requested sleep time in milliseconds
+ * @return true if the system timer was stretched and the MCU slept
+ */
+bool g_sys_tick_sleep(uint32_t ms);
+
 uint64_t g_get_micros(void);
 
+uint64_t g_get_nanos(void);
+
 uint32_t g_get_millis(void);
 
+uint64_t g_get_millis64(void);
+
 bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t count, uint8_t prio);
 
 void g_hw_timer_stop(hard_tim_t* timer);
 
+/*
+ * @brief Start the hardware timer with 1 us resolution and the first update after delay_us.
+ */
+bool g_hw_timer_start_us(hard_tim_t* timer, void (*callback) (void), uint32_t delay_us, uint8_t prio);
+
+/*
+ * @brief Restart the 1 us timer counting (see g_hw_timer_start_us) with the next update after delay_us.
+ */
+void g_hw_timer_rearm_us(hard_tim_t* timer, uint32_t delay_us);
+
+/*
+ * @brief Start the general purpose timer as a free running 16-bit 1 us counter.
+ *        The callback is called on every counter overflow and on the channel 1 compare.
+ */
+bool g_hw_timer_start_free_us(hard_tim_t* timer, void (*callback) (void), uint8_t prio);
+
+uint16_t g_hw_timer_count(hard_tim_t* timer);
+
+/*
+ * @brief Enable the channel 1 compare interrupt at the counter value.
+ */
+void g_hw_timer_set_compare(hard_tim_t* timer, uint16_t count);
+
+/*
+ * @brief Raise the channel 1 compare interrupt by software.
+ */
+void g_hw_timer_force_compare(hard_tim_t* timer);
+
+void g_hw_timer_stop_compare(hard_tim_t* timer);
+
+/*
+ * @brief Number of hardware timers not claimed by g_hw_timer_start*().
+ */
+uint32_t g_hw_timers_unclaimed(void);
+
 
 #ifdef __cplusplus
 }
@@ -155,6 +155,10 @@ void gsys_TIM2_IRQHandler(void) {
     	TIM2->SR &= ~TIM_SR_UIF;
     	_use_callback(TIM2, TIM2_IRQHandler);
     }
+    if ((TIM2->DIER & TIM_DIER_CC1IE) && (TIM2->SR & TIM_SR_CC1IF)) {
+    	TIM2->SR = ~TIM_SR_CC1IF;
+    	_use_callback(TIM2, TIM2_IRQHandler);
+    }
 }
 #endif
 
@@ -165,6 +169,10 @@ void gsys_TIM3_IRQHandler(void) {
     	TIM3->SR &= ~TIM_SR_UIF;
     	_use_callback(TIM3, TIM3_IRQHandler);
     }
+    if ((TIM3->DIER & TIM_DIER_CC1IE) && (TIM3->SR & TIM_SR_CC1IF)) {
+    	TIM3->SR = ~TIM_SR_CC1IF;
+    	_use_callback(TIM3, TIM3_IRQHandler);
+    }
 }
 #endif
 
@@ -175,6 +183,10 @@ void gsys_TIM4_IRQHandler(void) {
     	TIM4->SR &= ~TIM_SR_UIF;
     	_use_callback(TIM4, TIM4_IRQHandler);
     }
+    if ((TIM4->DIER & TIM_DIER_CC1IE) && (TIM4->SR & TIM_SR_CC1IF)) {
+    	TIM4->SR = ~TIM_SR_CC1IF;
+    	_use_callback(TIM4, TIM4_IRQHandler);
+    }
 }
 #endif
 
@@ -185,6 +197,10 @@ void gsys_TIM5_IRQHandler(void) {
     	TIM5->SR &= ~TIM_SR_UIF;
     	_use_callback(TIM5, TIM5_IRQHandler);
     }
+    if ((TIM5->DIER & TIM_DIER_CC1IE) && (TIM5->SR & TIM_SR_CC1IF)) {
+    	TIM5->SR = ~TIM_SR_CC1IF;
+    	_use_callback(TIM5, TIM5_IRQHandler);
+    }
 }
 #endif
 
@@ -493,10 +509,20 @@ static uint32_t _get_bus_freq(hard_tim_t* timer)
 #endif
 }
 
-extern uint32_t sys_time_ms;
+#if defined(GSYSTEM_DWT_MICROS)
+    #if !defined(DWT)
+        #error "GSYSTEM_DWT_MICROS requires the DWT cycle counter (Cortex-M3/M4/M7)"
+    #endif
+static volatile uint32_t sys_tick_cyc = 0; // DWT cycle counter at the last system tick
+static uint32_t cyc_per_us = 1;
+#endif
+
 static void _sys_timer_callback()
 {
-    sys_time_ms++;
+#if defined(GSYSTEM_DWT_MICROS)
+    sys_tick_cyc = DWT->CYCCNT;
+#endif
+    g_sys_time_add(1);
 }
 
 void g_reboot()
@@ -590,9 +616,74 @@ bool g_sys_tick_start(hard_tim_t* timer)
 
     sys_timer = timer;
 
+#if defined(GSYSTEM_DWT_MICROS)
+    cyc_per_us = __max(SystemCoreClock / 1000000, 1UL);
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    sys_tick_cyc = DWT->CYCCNT;
+#endif
+
     return g_hw_timer_start(timer, _sys_timer_callback, presc - 1, count - 1, 5);
 }
 
+bool g_sys_tick_sleep(uint32_t ms)
+{
+#if defined(GSYSTEM_TIMER)
+    if (!sys_timer) {
+        return false;
+    }
+
+    int idx = _get_timer_index(sys_timer);
+    if (idx < 0) {
+        return false;
+    }
+
+    uint32_t count = sys_timer->ARR + 1;
+    uint32_t max_ms = (0xFFFF + 1) / count;
+    if (ms > max_ms) {
+        ms = max_ms;
+    }
+    // Tick is pending or the sleep is too short to stretch the period for
+    if (ms < 2 || (sys_timer->SR & TIM_SR_UIF)) {
+        return false;
+    }
+
+    // ARR preload is disabled: the new period is applied to the current one
+    sys_timer->ARR = ms * count - 1;
+    // The update fired between the check and the stretch: the stretched period
+    // started from it and the wake up would count it as the whole sleep
+    if (sys_timer->SR & TIM_SR_UIF) {
+        sys_timer->ARR = count - 1;
+        return false;
+    }
+
+    __DSB();
+    __WFI();
+
+    uint32_t cnt = sys_timer->CNT;
+    uint32_t elapsed_ms = cnt / count;
+    if (sys_timer->SR & TIM_SR_UIF) {
+        sys_timer->SR &= ~TIM_SR_UIF;
+        HAL_NVIC_ClearPendingIRQ((IRQn_Type)tims[idx].irq);
+        elapsed_ms += ms;
+    }
+
+    sys_timer->CNT = cnt % count;
+    sys_timer->ARR = count - 1;
+
+#if defined(GSYSTEM_DWT_MICROS)
+    sys_tick_cyc = DWT->CYCCNT - (cnt % count) * MILLIS_US / count * cyc_per_us;
+#endif
+    g_sys_time_add(elapsed_ms);
+
+    return true;
+#else
+    (void)ms;
+    return false;
+#endif
+}
+
 bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t count, uint8_t prio)
 {
     int idx = _get_timer_index(timer);
@@ -638,7 +729,9 @@ void g_hw_timer_stop(hard_tim_t* timer)
 
 	HAL_NVIC_DisableIRQ((IRQn_Type)tims[idx].irq);
 
-	timer->DIER &= ~TIM_DIER_UIE;
+	tims[idx].callback = NULL;
+
+	timer->DIER &= ~(TIM_DIER_UIE | TIM_DIER_CC1IE);
 
     timer->SR &= ~(TIM_SR_UIF | TIM_SR_CC1IF);
 
@@ -648,6 +741,91 @@ void g_hw_timer_stop(hard_tim_t* timer)
     BEDUG_ASSERT(_disable_timer_clock(timer), "Disable timer error");
 }
 
+bool g_hw_timer_start_us(hard_tim_t* timer, void (*callback) (void), uint32_t delay_us, uint8_t prio)
+{
+    uint32_t freq = _get_bus_freq(timer);
+    if (!freq || freq % SECOND_US) {
+        BEDUG_ASSERT(false, "Timer frequency is not a multiple of 1 MHz");
+        return false;
+    }
+
+    uint32_t presc = freq / SECOND_US;
+    if (presc - 1 > 0xFFFF) {
+        BEDUG_ASSERT(false, "Timer prescaler is out of range");
+        return false;
+    }
+
+    return g_hw_timer_start(timer, callback, presc - 1, __max(__min(delay_us, 0x10000), 1) - 1, prio);
+}
+
+void g_hw_timer_rearm_us(hard_tim_t* timer, uint32_t delay_us)
+{
+    timer->ARR = __max(__min(delay_us, 0x10000), 1) - 1;
+    timer->CNT = 0;
+}
+
+bool g_hw_timer_start_free_us(hard_tim_t* timer, void (*callback) (void), uint8_t prio)
+{
+	bool general_purpose = false;
+#ifdef TIM2
+	general_purpose |= (timer == TIM2);
+#endif
+#ifdef TIM3
+	general_purpose |= (timer == TIM3);
+#endif
+#ifdef TIM4
+	general_purpose |= (timer == TIM4);
+#endif
+#ifdef TIM5
+	general_purpose |= (timer == TIM5);
+#endif
+	if (!general_purpose) {
+		BEDUG_ASSERT(false, "Free running timer must be TIM2-TIM5");
+		return false;
+	}
+
+	if (!g_hw_timer_start_us(timer, callback, 0x10000, prio)) {
+		return false;
+	}
+	timer->CCMR1 &= ~(TIM_CCMR1_CC1S | TIM_CCMR1_OC1M);
+	return true;
+}
+
+uint16_t g_hw_timer_count(hard_tim_t* timer)
+{
+	return (uint16_t)timer->CNT;
+}
+
+void g_hw_timer_set_compare(hard_tim_t* timer, uint16_t count)
+{
+	timer->CCR1  = count;
+	timer->SR    = ~TIM_SR_CC1IF;
+	timer->DIER |= TIM_DIER_CC1IE;
+}
+
+void g_hw_timer_force_compare(hard_tim_t* timer)
+{
+	timer->DIER |= TIM_DIER_CC1IE;
+	timer->EGR   = TIM_EGR_CC1G;
+}
+
+void g_hw_timer_stop_compare(hard_tim_t* timer)
+{
+	timer->DIER &= ~TIM_DIER_CC1IE;
+	timer->SR    = ~TIM_SR_CC1IF;
+}
+
+uint32_t g_hw_timers_unclaimed(void)
+{
+	uint32_t count = 0;
+	for (unsigned i = 0; i < __arr_len(tims); i++) {
+		if (!tims[i].callback) {
+			count++;
+		}
+	}
+	return count;
+}
+
 uint32_t g_get_millis(void)
 {
 #if defined(GSYSTEM_TIMER)
@@ -657,33 +835,63 @@ uint32_t g_get_millis(void)
 #endif
 }
 
-uint64_t g_get_micros(void)
+uint64_t g_get_millis64(void)
 {
 #if defined(GSYSTEM_TIMER)
-	uint32_t primask = __get_PRIMASK();
-	__disable_irq();
-
-	uint32_t ms = sys_time_ms;
-	uint32_t cnt = sys_timer->CNT;
-	bool overflow_pending = (sys_timer->SR & TIM_SR_UIF) != 0;
-
-	__set_PRIMASK(primask);
-
-	if (overflow_pending && (cnt < (sys_timer->ARR / 2))) {
-		ms++;
-	}
+    return g_sys_time_read_ms64();
+#else
+    return (uint64_t)getMillis();
+#endif
+}
 
-	if (sys_timer->ARR == MILLIS_US - 1) {
-		return (uint64_t)sys_time_ms * (uint64_t)MILLIS_US + cnt;
+#if defined(GSYSTEM_DWT_MICROS)
+/*
+ * @brief Milliseconds and CPU cycles since the last system tick.
+ *        The cycles are clamped to one millisecond: the tick may be pending
+ *        behind a higher priority interrupt, the time must stay monotonic.
+ */
+static uint64_t _get_millis_cyc(uint32_t* cyc)
+{
+	uint32_t ms;
+	uint32_t half;
+	do {
+		half = sys_time_ms_half;
+		ms   = sys_time_ms;
+		*cyc = DWT->CYCCNT - sys_tick_cyc;
+	} while (ms != sys_time_ms);
+
+	uint32_t max_cyc = cyc_per_us * MILLIS_US - 1;
+	if (*cyc > max_cyc) {
+		*cyc = max_cyc;
 	}
+	return g_sys_time_ms64(half, ms);
+}
+#endif
 
-	uint64_t us_from_cnt = ((uint64_t)cnt * (uint64_t)MILLIS_US) / (uint64_t)(sys_timer->ARR + 1);
-	return ((uint64_t)ms * (uint64_t)MILLIS_US) + us_from_cnt;
+uint64_t g_get_micros(void)
+{
+#if defined(GSYSTEM_DWT_MICROS)
+	uint32_t cyc = 0;
+	uint64_t ms  = _get_millis_cyc(&cyc);
+	return ms * (uint64_t)MILLIS_US + cyc / cyc_per_us;
+#elif defined(GSYSTEM_TIMER)
+	return g_sys_time_us(sys_timer);
 #else
     return getMicroseconds();
 #endif
 }
 
+uint64_t g_get_nanos(void)
+{
+#if defined(GSYSTEM_DWT_MICROS)
+	uint32_t cyc = 0;
+	uint64_t ms  = _get_millis_cyc(&cyc);
+	return ms * 1000000ULL + (uint64_t)(cyc / cyc_per_us) * 1000 + (cyc % cyc_per_us) * 1000 / cyc_per_us;
+#else
+	return g_get_micros() * 1000;
+#endif
+}
+
 void g_restart_check() 
 {
     bool flag = false;
@@ -1052,4 +1260,26 @@ void g_delay_ms(const uint32_t ms)
     while (gtimer_wait(&timer));
 }
 
+void g_delay_us(const uint32_t us)
+{
+#if defined(DWT)
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+	uint64_t cycles  = (uint64_t)us * __max(SystemCoreClock / SECOND_US, 1UL);
+	uint64_t elapsed = 0;
+	uint32_t last    = DWT->CYCCNT;
+	while (elapsed < cycles) {
+		uint32_t cyc = DWT->CYCCNT;
+		elapsed += cyc - last;
+		last     = cyc;
+	}
+#else
+	// system_micros() does not read the system timer before it is started
+	uint64_t start_us = system_micros();
+	while (system_micros() - start_us < us);
+#endif
+}
+
 #endif
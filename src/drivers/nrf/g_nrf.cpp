@@ -25,19 +25,34 @@
 #define VECTOR_TABLE_ALIGN __attribute__((aligned(0x200)))
 
 
+// COMPARE0 - the period (the overflow of the free running counter), COMPARE1 - the compare channel
 #define TIMER_IRQ_HANDLER(idx, reg) \
 extern "C" void TIMER##idx##_IRQHandler() { \
+    bool fired = false; \
     if (reg->EVENTS_COMPARE[0]) { \
         reg->EVENTS_COMPARE[0] = 0; \
         (void)reg->EVENTS_COMPARE[0]; \
-        if (TIM_CALLBACKS[idx]) { \
-            TIM_CALLBACKS[idx](); \
-        } \
+        fired = true; \
+    } \
+    if ((reg->INTENSET & TIMER_INTENSET_COMPARE1_Msk) && (reg->EVENTS_COMPARE[1] || TIM_FORCED[idx])) { \
+        reg->EVENTS_COMPARE[1] = 0; \
+        (void)reg->EVENTS_COMPARE[1]; \
+        TIM_FORCED[idx] = false; \
+        fired = true; \
+    } \
+    if (fired && TIM_CALLBACKS[idx]) { \
+        TIM_CALLBACKS[idx](); \
     } \
 }
 
 
 static void (*TIM_CALLBACKS[5])(void) = {NULL, NULL, NULL, NULL, NULL};
+// Software compare interrupt requests (g_hw_timer_force_compare)
+static volatile bool TIM_FORCED[5] = {false, false, false, false, false};
+
+// Free running counter channels: CC[0] - overflow, CC[1] - compare, CC[2] - counter capture
+static const unsigned TIM_FREE_COMPARE_CH = 1;
+static const unsigned TIM_FREE_CAPTURE_CH = 2;
 
 
 TIMER_IRQ_HANDLER(0, NRF_TIMER0)
@@ -77,10 +92,9 @@ static int _get_timer_index(hard_tim_t* timer)
     return -1;
 }
 
-extern "C" uint32_t sys_time_ms;
 static void _sys_timer_callback()
 {
-    sys_time_ms++;
+    g_sys_time_add(1);
 }
 
 extern "C" void g_reboot()
@@ -108,7 +122,14 @@ bool g_sys_tick_start(hard_tim_t* timer)
     return g_hw_timer_start(timer, _sys_timer_callback, g_get_millis_hw_tim_presc(), g_get_millis_hw_tim_count(), 5);
 }
 
-bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t cnt, uint8_t prio)
+bool g_sys_tick_sleep(uint32_t ms)
+{
+    // Tickless idle is disabled on nRF52 (see gdefines.h)
+    (void)ms;
+    return false;
+}
+
+static bool _hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t cnt, uint32_t shorts, uint8_t prio)
 {
     int idx = _get_timer_index(timer);
     if (idx < 0) {
@@ -122,6 +143,7 @@ bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc
     }
 
     TIM_CALLBACKS[idx] = callback;
+    TIM_FORCED[idx]    = false;
 
     // Остановить и очистить
     timer->TASKS_STOP = 1;
@@ -133,9 +155,11 @@ bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc
     timer->PRESCALER = presc;
     timer->CC[0] = cnt;
 
-    // Auto compare reset
-    timer->SHORTS = TIMER_SHORTS_COMPARE0_CLEAR_Msk;
+    timer->SHORTS = shorts;
     // IRQ
+    timer->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+    timer->EVENTS_COMPARE[0] = 0;
+    timer->EVENTS_COMPARE[1] = 0;
     timer->INTENSET = TIMER_INTENSET_COMPARE0_Msk;
 
     // Включаем прерывание
@@ -149,6 +173,12 @@ bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc
     return true;
 }
 
+bool g_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t cnt, uint8_t prio)
+{
+    // Auto compare reset
+    return _hw_timer_start(timer, callback, presc, cnt, TIMER_SHORTS_COMPARE0_CLEAR_Msk, prio);
+}
+
 void g_hw_timer_stop(hard_tim_t* timer)
 {
     int idx = _get_timer_index(timer);
@@ -157,11 +187,15 @@ void g_hw_timer_stop(hard_tim_t* timer)
         return;
     }
 
+    TIM_CALLBACKS[idx] = NULL;
+    TIM_FORCED[idx]    = false;
+
     timer->TASKS_STOP = 1;
     timer->TASKS_CLEAR = 1;
 
-    timer->INTENCLR = TIMER_INTENCLR_COMPARE0_Msk;
+    timer->INTENCLR = TIMER_INTENCLR_COMPARE0_Msk | TIMER_INTENCLR_COMPARE1_Msk;
     timer->EVENTS_COMPARE[0] = 0;
+    timer->EVENTS_COMPARE[1] = 0;
 
     IRQn_Type irq = tim_irqs[idx];
     NVIC_ClearPendingIRQ(irq);
@@ -171,6 +205,74 @@ void g_hw_timer_stop(hard_tim_t* timer)
     __ISB();
 }
 
+bool g_hw_timer_start_us(hard_tim_t* timer, void (*callback) (void), uint32_t delay_us, uint8_t prio)
+{
+    // 16 MHz / 2^4 = 1 MHz
+    return g_hw_timer_start(timer, callback, 4, __max(__min(delay_us, 0xFFFF), 1), prio);
+}
+
+void g_hw_timer_rearm_us(hard_tim_t* timer, uint32_t delay_us)
+{
+    timer->TASKS_CLEAR = 1;
+    timer->CC[0] = __max(__min(delay_us, 0xFFFF), 1);
+}
+
+bool g_hw_timer_start_free_us(hard_tim_t* timer, void (*callback) (void), uint8_t prio)
+{
+    if (timer == sys_timer) {
+        BEDUG_ASSERT(false, "Free running timer must not be the system timer");
+        return false;
+    }
+    // 16 MHz / 2^4 = 1 MHz, no shortcuts: the 16-bit counter wraps, CC[0] = 0 is the overflow
+    return _hw_timer_start(timer, callback, 4, 0, 0, prio);
+}
+
+uint16_t g_hw_timer_count(hard_tim_t* timer)
+{
+    timer->TASKS_CAPTURE[TIM_FREE_CAPTURE_CH] = 1;
+    return (uint16_t)timer->CC[TIM_FREE_CAPTURE_CH];
+}
+
+void g_hw_timer_set_compare(hard_tim_t* timer, uint16_t count)
+{
+    timer->CC[TIM_FREE_COMPARE_CH] = count;
+    timer->EVENTS_COMPARE[TIM_FREE_COMPARE_CH] = 0;
+    timer->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+}
+
+void g_hw_timer_force_compare(hard_tim_t* timer)
+{
+    int idx = _get_timer_index(timer);
+    if (idx < 0) {
+        BEDUG_ASSERT(false, "Unknown NRF TIMER");
+        return;
+    }
+    TIM_FORCED[idx] = true;
+    timer->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+    NVIC_SetPendingIRQ(tim_irqs[idx]);
+}
+
+void g_hw_timer_stop_compare(hard_tim_t* timer)
+{
+    timer->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+    timer->EVENTS_COMPARE[TIM_FREE_COMPARE_CH] = 0;
+    int idx = _get_timer_index(timer);
+    if (idx >= 0) {
+        TIM_FORCED[idx] = false;
+    }
+}
+
+uint32_t g_hw_timers_unclaimed(void)
+{
+    uint32_t count = 0;
+    for (unsigned i = 0; i < sizeof(TIM_CALLBACKS) / sizeof(*TIM_CALLBACKS); i++) {
+        if (!TIM_CALLBACKS[i]) {
+            count++;
+        }
+    }
+    return count;
+}
+
 extern "C" uint32_t g_get_millis(void)
 {
 #if defined(GSYSTEM_TIMER)
@@ -180,23 +282,34 @@ extern "C" uint32_t g_get_millis(void)
 #endif
 }
 
+extern "C" uint64_t g_get_millis64(void)
+{
+#if defined(GSYSTEM_TIMER)
+    return g_sys_time_read_ms64();
+#else
+    return (uint64_t)getMillis();
+#endif
+}
+
 extern "C" uint64_t g_get_micros(void)
 {
 #if defined(GSYSTEM_TIMER)
     const int CAP_CH = 1;
-    uint32_t ms;
+    uint32_t ms32;
+    uint32_t half;
     uint32_t cc;
     bool overflow_pending;
 
-    uint32_t primask = __get_PRIMASK();
-    __disable_irq();
-
-    ms = sys_time_ms;
-    sys_timer->TASKS_CAPTURE[CAP_CH] = 1;
-    cc = sys_timer->CC[CAP_CH];    
-    overflow_pending = (sys_timer->EVENTS_COMPARE[0] != 0);
+    // Double read instead of IRQ masking: retried if the system tick was handled in between
+    do {
+        half = sys_time_ms_half;
+        ms32 = sys_time_ms;
+        sys_timer->TASKS_CAPTURE[CAP_CH] = 1;
+        cc = sys_timer->CC[CAP_CH];
+        overflow_pending = (sys_timer->EVENTS_COMPARE[0] != 0);
+    } while (ms32 != sys_time_ms);
 
-    __set_PRIMASK(primask);
+    uint64_t ms = g_sys_time_ms64(half, ms32);
 
     if (overflow_pending && (cc < (sys_timer->CC[0] / 2))) {
         ms++;
@@ -207,6 +320,11 @@ extern "C" uint64_t g_get_micros(void)
 #endif
 }
 
+extern "C" uint64_t g_get_nanos(void)
+{
+    return g_get_micros() * 1000;
+}
+
 extern "C" void g_restart_check() 
 {
     uint32_t reset_reason = NRF_POWER->RESETREAS;
@@ -331,4 +449,11 @@ extern "C" void g_delay_ms(const uint32_t ms)
     while (timer.wait());
 }
 
+extern "C" void g_delay_us(const uint32_t us)
+{
+    // system_micros() does not read the system timer before it is started
+    uint64_t start_us = system_micros();
+    while (system_micros() - start_us < us);
+}
+
 #endif // #ifdef NRF52
@@ -28,9 +28,49 @@ extern "C" {
  *
  * - `GSYSTEM_RESET_TIMEOUT_MS` : milliseconds before forced reset in system error state.
  * - `GSYSTEM_POCESSES_COUNT`   : predefined number of scheduler processes.
+ * - `GSYSTEM_POST_QUEUE_SIZE`  : system_post() deferred work queue size (power of 2).
+ * - `GSYSTEM_YIELD_MIN_US`     : system_yield_delay_us() waits shorter than this spin on the
+ *                                cycle counter instead of running scheduler passes (default 50).
  */
 // #define GSYSTEM_RESET_TIMEOUT_MS    (30000)
 // #define GSYSTEM_POCESSES_COUNT      (32)
+// #define GSYSTEM_POST_QUEUE_SIZE     (16)
+// #define GSYSTEM_YIELD_MIN_US        (50)
+
+/*
+ * Event broker
+ *
+ * - `GSYSTEM_EVENT_SUBSCRIBERS` : X-list of event subscribers (topic, handler), the handlers
+ *                                 are `void handler(const gsys_event_t* event)` and are called
+ *                                 from system_tick(). Topics without subscribers are not published.
+ * - `GSYSTEM_EVENT_POOL_SIZE`   : number of events waiting for delivery (max 32, default 8).
+ */
+// #define GSYSTEM_EVENT_SUBSCRIBERS(X) \
+//     X(GSYS_EVENT_ERROR,  on_system_error) \
+//     X(GSYS_EVENT_BUTTON, on_button)
+// #define GSYSTEM_EVENT_POOL_SIZE     (8)
+
+/*
+ * Power management
+ *
+ * - `GSYSTEM_TICKLESS_IDLE`    : sleep the MCU (WFI) in system_start() until the nearest job
+ *                                deadline. The GSYSTEM_TIMER period is stretched for the sleep
+ *                                and system time is compensated on wake up. Requires GSYSTEM_TIMER,
+ *                                STM32 only (ignored on nRF52).
+ * - `GSYSTEM_TICKLESS_MIN_MS`  : minimal idle time in ms to stretch the system timer for
+ *                                (shorter idle periods sleep until the next system tick).
+ */
+// #define GSYSTEM_TICKLESS_IDLE
+// #define GSYSTEM_TICKLESS_MIN_MS     (2)
+
+/*
+ * System time
+ *
+ * - `GSYSTEM_DWT_MICROS` : interpolate system_micros()/system_nanos() inside the system tick
+ *                          with the DWT cycle counter (Cortex-M3/M4/M7, STM32 HAL only) for
+ *                          sub-microsecond timestamps. Requires GSYSTEM_TIMER.
+ */
+// #define GSYSTEM_DWT_MICROS
 
 /*
  * Feature toggles (define to "in library" disable feature)
@@ -93,6 +133,76 @@ extern "C" {
 // #define GSYSTEM_NO_PROC_INFO
 // #define GSYSTEM_NO_BEDUG
 
+/*
+ * Earliest-deadline-first scheduling
+ *
+ * - `GSYSTEM_SCHEDULER_EDF`     : enable system_register_rt() tasks with WCET budgets and deadlines,
+ *                                 launched in EDF order with utilization-based admission control.
+ * - `GSYSTEM_EDF_MAX_LOAD_X100` : max admitted EDF utilization in % x100 (default 7000 - 70%), the rest
+ *                                 is left for the other tasks and for non-preemptive blocking.
+ */
+// #define GSYSTEM_SCHEDULER_EDF
+// #define GSYSTEM_EDF_MAX_LOAD_X100   (7000)
+
+/*
+ * Scheduler latency histograms
+ *
+ * - `GSYSTEM_PROC_HISTOGRAM`   : keep log2-bucket histograms of execution time and start jitter
+ *                                for every job (72 bytes per job), see system_job_latency().
+ * - `GSYSTEM_PROC_SCALE_P99`   : use p99 execution time instead of the smoothed execution sum
+ *                                for the adaptive job scaling (requires GSYSTEM_PROC_HISTOGRAM).
+ */
+// #define GSYSTEM_PROC_HISTOGRAM
+// #define GSYSTEM_PROC_SCALE_P99
+
+/*
+ * Scheduler trace
+ *
+ * - `GSYSTEM_TRACE`      : record every job launch (12-byte records: job id, start us, duration,
+ *                          ISR/main tier, deny reason) into a RAM ring buffer, see system_trace_dump().
+ * - `GSYSTEM_TRACE_SIZE` : number of trace records in the ring buffer (power of 2, default 256).
+ */
+// #define GSYSTEM_TRACE
+// #define GSYSTEM_TRACE_SIZE          (256)
+
+/*
+ * Timer wheel
+ *
+ * - `GSYSTEM_TIMER_WHEEL` : enable callback soft timers (system_wtimer_start()) on a hierarchical
+ *                           timing wheel advanced by system_tick(), O(1) start/stop for any number
+ *                           of caller-owned timers (640 bytes of RAM for the wheel slots).
+ */
+// #define GSYSTEM_TIMER_WHEEL
+
+/*
+ * Soul flight recorder
+ *
+ * - `GSYSTEM_SOUL_LOG`        : record every status and error transition (8-byte records: status,
+ *                               set/reset, system_millis(), boot counter) into a RAM ring that survives
+ *                               warm resets, see system_soul_log_get(). The linker script must place
+ *                               the .noinit section into RAM as NOLOAD. Recovered records and full chunks
+ *                               are stored to the memory (StorageAT, "SLG" prefix) by a background job.
+ * - `GSYSTEM_SOUL_LOG_SIZE`   : number of records in the RAM ring (power of 2, min 16, default 64).
+ * - `GSYSTEM_SOUL_LOG_CHUNKS` : number of rotating 16-record chunks in the memory (default 8).
+ */
+// #define GSYSTEM_SOUL_LOG
+// #define GSYSTEM_SOUL_LOG_SIZE       (64)
+// #define GSYSTEM_SOUL_LOG_CHUNKS     (8)
+
+/*
+ * Crash dump
+ *
+ * - `GSYSTEM_CRASH_DUMP`        : HardFault/MemManage/BusFault/UsageFault handlers save the exception
+ *                                 frame, fault status registers, a stack slice and the running job into
+ *                                 the .noinit RAM and reset at once (Cortex-M3/M4/M7). The dump is printed
+ *                                 and stored to the memory (StorageAT, "CRH" prefix) after the reset,
+ *                                 see system_crash_dump_get(). Needs the .noinit linker section and
+ *                                 512 bytes of RAM for the crash stack.
+ * - `GSYSTEM_CRASH_STACK_WORDS` : stack words saved above the exception frame (max 255, default 32).
+ */
+// #define GSYSTEM_CRASH_DUMP
+// #define GSYSTEM_CRASH_STACK_WORDS   (32)
+
 /*
  * ADC configuration
  *
@@ -156,6 +266,30 @@ extern "C" {
  */
 // #define GSYSTEM_TIMER              (TIM1)
 
+/*
+ * ISR scheduler
+ *
+ * - `GSYSTEM_ISR_TIMER`        : hardware timer (1 us resolution) dedicated to system_register_isr() jobs
+ *                                (e.g. TIM2); without it the ISR jobs run from system_tick_isr() calls.
+ * - `GSYSTEM_ISR_TIMER_PRIO`   : ISR timer interrupt priority (default 4, above GSYSTEM_TIMER).
+ * - `GSYSTEM_ISR_BUDGET_US`    : max time in us for one ISR scheduler pass, the rest of the due jobs
+ *                                are launched on the next compare (default 50).
+ */
+// #define GSYSTEM_ISR_TIMER          (TIM2)
+// #define GSYSTEM_ISR_TIMER_PRIO     (4)
+// #define GSYSTEM_ISR_BUDGET_US      (50)
+
+/*
+ * High-resolution timers
+ *
+ * - `GSYSTEM_HRT_TIMER`        : general purpose hardware timer (TIM2-TIM5) running free at 1 MHz,
+ *                                its channel 1 compare multiplexes system_hrt_start() one-shot timers
+ *                                (e.g. TIM3, on nRF52 a TIMER other than the system timer: NRF_TIMER2).
+ * - `GSYSTEM_HRT_TIMER_PRIO`   : HRT timer interrupt priority, the callbacks run at it (default 3).
+ */
+// #define GSYSTEM_HRT_TIMER          (TIM3)
+// #define GSYSTEM_HRT_TIMER_PRIO     (3)
+
 // #define GSYSTEM_BEDUG_UART         (huart2)
 
 // #define GSYSTEM_I2C                (hi2c2)
@@ -184,12 +318,24 @@ extern "C" {
 /*
  * Custom user device status codes
  *
- * Extend soul.h definitions as needed.
+ * Extend soul.h definitions as needed. Names printed by get_status_name()
+ * are registered with `GSYSTEM_CUSTOM_STATUS_NAMES(X)`: call `X(STATUS)` for
+ * every custom status, the names are added to the constant status name table
+ * at compile time.
+ *
+ * Migration: the weak `char* get_custom_status_name(SOUL_STATUS)` hook is
+ * removed and a project override of it is no longer called. Move the names
+ * it returned into `GSYSTEM_CUSTOM_STATUS_NAMES(X)`. get_status_name() now
+ * returns the bare constant name: print it with SOUL_STATUS_FMT and
+ * SOUL_STATUS_ARG() to keep the "[%03u] NAME" output.
  */
 // typedef enum _CUSTOM_SOUL_STATUSES {
 // 	CUSTOM_STATUS_01 = RESERVED_STATUS_01,
 // 	CUSTOM_STATUS_02 = RESERVED_STATUS_02
 // } CUSTOM_SOUL_STATUSES;
+// #define GSYSTEM_CUSTOM_STATUS_NAMES(X) \
+// 	X(CUSTOM_STATUS_01)               \
+// 	X(CUSTOM_STATUS_02)
 
 
 /*
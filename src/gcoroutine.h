@@ -0,0 +1,144 @@
+/*
+ * @file gcoroutine.h
+ * @brief Stackless (protothread-style) coroutines for scheduler jobs.
+ *
+ * A coroutine job is a regular job registered with system_register() whose
+ * body is wrapped into GSYS_CORO_BEGIN/GSYS_CORO_END. An await macro saves
+ * the resume point and returns to the scheduler, the next launch of the job
+ * continues from the saved point, so other jobs keep running while a slow
+ * job waits for a delay, a soul status or a storage operation.
+ *
+ * Rules (the coroutine has no stack of its own):
+ * - Locals are not kept between launches: keep the state in static variables
+ *   or in a context structure.
+ * - Awaits are allowed only in the coroutine function body, not in nested
+ *   calls or inside a switch statement.
+ * - The job period is the poll interval of an await, register coroutine
+ *   jobs with a short period.
+ *
+ * @example
+ * void flash_job(void)
+ * {
+ *     static gsys_coro_t coro = {};
+ *     GSYS_CORO_BEGIN(&coro);
+ *     start_erase();
+ *     GSYS_CORO_AWAIT(&coro, erase_done());
+ *     GSYS_CORO_DELAY(&coro, 100);
+ *     GSYS_CORO_AWAIT_STATUS(&coro, MEMORY_INITIALIZED);
+ *     GSYS_CORO_END(&coro);
+ * }
+ * ...
+ * system_register(flash_job, 1, false, false, 100);
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _GCOROUTINE_H_
+#define _GCOROUTINE_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "soul.h"
+#include "gsystem.h"
+
+
+/* @brief The await resume point is reached from its own statement too */
+#if defined(__has_attribute)
+    #if __has_attribute(fallthrough)
+        #define GSYS_CORO_FALLTHROUGH __attribute__((fallthrough))
+    #endif
+#endif
+#ifndef GSYS_CORO_FALLTHROUGH
+    #define GSYS_CORO_FALLTHROUGH
+#endif
+
+
+/*
+ * Coroutine state: zero initialized state starts from the beginning.
+ */
+typedef struct _gsys_coro_t {
+    uint16_t line;      // Resume point (source line of the await), 0 - start
+    uint32_t start_ms;  // Start time of the current delay or timeout
+} gsys_coro_t;
+
+
+/* @brief Start of the coroutine body */
+#define GSYS_CORO_BEGIN(CORO) \
+    switch ((CORO)->line) {   \
+    case 0:
+
+/* @brief End of the coroutine body: the next launch starts from the beginning */
+#define GSYS_CORO_END(CORO) \
+    }                       \
+    (CORO)->line = 0;       \
+    return
+
+/* @brief Return to the scheduler, the next launch continues after the yield */
+#define GSYS_CORO_YIELD(CORO)            \
+    do {                                 \
+        (CORO)->line = (uint16_t)__LINE__; \
+        return;                          \
+    case __LINE__:;                      \
+    } while (0)
+
+/* @brief Return to the scheduler until the condition is true */
+#define GSYS_CORO_AWAIT(CORO, COND)      \
+    do {                                 \
+        (CORO)->line = (uint16_t)__LINE__; \
+        GSYS_CORO_FALLTHROUGH;           \
+    case __LINE__:                       \
+        if (!(COND)) {                   \
+            return;                      \
+        }                                \
+    } while (0)
+
+/* @brief Return to the scheduler for DELAY_MS milliseconds */
+#define GSYS_CORO_DELAY(CORO, DELAY_MS)                                                   \
+    do {                                                                                  \
+        (CORO)->start_ms = system_millis();                                               \
+        GSYS_CORO_AWAIT(CORO, (uint32_t)(system_millis() - (CORO)->start_ms) >= (uint32_t)(DELAY_MS)); \
+    } while (0)
+
+/*
+ * @brief Return to the scheduler until the condition is true or TIMEOUT_MS
+ *        is over, check the condition again after the await to tell them apart.
+ */
+#define GSYS_CORO_AWAIT_TIMEOUT(CORO, COND, TIMEOUT_MS)                                   \
+    do {                                                                                  \
+        (CORO)->start_ms = system_millis();                                               \
+        GSYS_CORO_AWAIT(                                                                  \
+            CORO,                                                                         \
+            (COND) || (uint32_t)(system_millis() - (CORO)->start_ms) >= (uint32_t)(TIMEOUT_MS) \
+        );                                                                                \
+    } while (0)
+
+/* @brief Return to the scheduler until the soul status is set */
+#define GSYS_CORO_AWAIT_STATUS(CORO, STATUS) GSYS_CORO_AWAIT(CORO, is_status(STATUS))
+
+/* @brief Return to the scheduler until the soul error is set */
+#define GSYS_CORO_AWAIT_ERROR(CORO, ERROR)   GSYS_CORO_AWAIT(CORO, is_error(ERROR))
+
+/* @brief Restart the coroutine from the beginning on the next launch */
+#define GSYS_CORO_RESTART(CORO) \
+    do {                        \
+        (CORO)->line = 0;       \
+        return;                 \
+    } while (0)
+
+/* @brief True if the coroutine is waiting in the middle of its body */
+#define GSYS_CORO_RUNNING(CORO) ((CORO)->line != 0)
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -22,24 +22,6 @@ extern "C" {
 
 #include "gconfig.h"
 
-/*
- * @def SYSTEM_CASE_STATUS(TARGET, STATUS)
- * @brief Helper macro used in switch statement in get_custom_status_name() 
- *        to convert status enums into human-readable strings.
- * @param TARGET (char[]) - Destination string buffer.
- * @param STATUS (enum) - Status enum identifier to convert.
- */
-#define SYSTEM_CASE_STATUS(TARGET, STATUS) \
-                                        case STATUS:                 \
-                                            snprintf(                \
-                                                TARGET,              \
-                                                sizeof(TARGET) - 1,  \
-                                                "%s",                \
-                                                __STR_DEF__(STATUS)  \
-                                            );                       \
-                                            break;
-
-
 /*
  * @def SYSTEM_CANARY_WORD
  * @brief Canary value used for simple integrity checks in memory structures.
@@ -110,63 +92,87 @@ extern const char SYSTEM_TAG[];
    #define GSYSTEM_POCESSES_COUNT (32)
 #endif
 
-#ifndef GSYSTEM_COLOR_DEFAULT
-	#define GSYSTEM_COLOR_DEFAULT "\x1b[0m"
+#ifndef GSYSTEM_POST_QUEUE_SIZE
+    #define GSYSTEM_POST_QUEUE_SIZE (16)
 #endif
-#ifndef GSYSTEM_COLOR_ERROR
-    #define GSYSTEM_COLOR_ERROR   "\x1b[31m"
+
+#ifndef GSYSTEM_EVENT_POOL_SIZE
+    #define GSYSTEM_EVENT_POOL_SIZE (8)
 #endif
-#ifndef GSYSTEM_COLOR_SUCCESS
-    #define GSYSTEM_COLOR_SUCCESS "\x1b[32m"
+
+#if defined(GSYSTEM_PROC_SCALE_P99) && !defined(GSYSTEM_PROC_HISTOGRAM)
+    #error "GSYSTEM_PROC_SCALE_P99 requires GSYSTEM_PROC_HISTOGRAM"
 #endif
-#ifndef GSYSTEM_COLOR_WARN
-    #define GSYSTEM_COLOR_WARN    "\x1b[33m"
+
+#ifndef GSYSTEM_EDF_MAX_LOAD_X100
+    #define GSYSTEM_EDF_MAX_LOAD_X100 (7000)
+#endif
+
+#ifndef GSYSTEM_TRACE_SIZE
+    #define GSYSTEM_TRACE_SIZE (256)
+#endif
+
+#ifndef GSYSTEM_ISR_TIMER_PRIO
+    #define GSYSTEM_ISR_TIMER_PRIO (4)
+#endif
+
+#ifndef GSYSTEM_SOUL_LOG_SIZE
+    #define GSYSTEM_SOUL_LOG_SIZE (64)
+#endif
+
+#ifndef GSYSTEM_SOUL_LOG_CHUNKS
+    #define GSYSTEM_SOUL_LOG_CHUNKS (8)
 #endif
 
-// Min gsystem proccesses counter
-#ifndef GSYSTEM_NO_MEMORY_W
-    #define __GC_CNT_MEMORY (1)
-#else
-    #define __GC_CNT_MEMORY (0)
+#ifndef GSYSTEM_CRASH_STACK_WORDS
+    #define GSYSTEM_CRASH_STACK_WORDS (32)
 #endif
-#ifndef GSYSTEM_NO_SYS_TICK_W
-    #define __GC_CNT_SYS_TICK (1)
-#else
-    #define __GC_CNT_SYS_TICK (0)
+
+#if GSYSTEM_CRASH_STACK_WORDS > 0xFF
+    #error "GSYSTEM_CRASH_STACK_WORDS must be less than 256"
 #endif
-#ifndef GSYSTEM_NO_RAM_W
-    #define __GC_CNT_RAM (1)
-#else
-    #define __GC_CNT_RAM (0)
+
+#ifndef GSYSTEM_YIELD_MIN_US
+    #define GSYSTEM_YIELD_MIN_US (50)
 #endif
-#if !defined(GSYSTEM_NO_ADC_W)
-    #define __GC_CNT_ADC (1)
-#else
-    #define __GC_CNT_ADC (0)
+
+#ifndef GSYSTEM_HRT_TIMER_PRIO
+    #define GSYSTEM_HRT_TIMER_PRIO (3)
 #endif
-#if defined(STM32F1) && !defined(GSYSTEM_NO_I2C_W)
-    #define __GC_CNT_I2C (1)
-#else
-    #define __GC_CNT_I2C (0)
+
+#ifndef GSYSTEM_ISR_BUDGET_US
+    #define GSYSTEM_ISR_BUDGET_US (50)
 #endif
-#if !defined(GSYSTEM_NO_POWER_W) && !defined(GSYSTEM_NO_ADC_W)
-    #define __GC_CNT_POWER (1)
-#else
-    #define __GC_CNT_POWER (0)
+
+#ifndef GSYSTEM_TICKLESS_MIN_MS
+    #define GSYSTEM_TICKLESS_MIN_MS (2)
 #endif
-#ifndef GSYSTEM_NO_RTC_W
-    #define __GC_CNT_RTC (1)
-#else
-    #define __GC_CNT_RTC (0)
+
+// nRF TIMER counter can't be written, so the stretched period remainder can't be restored
+#if defined(NRF52) && defined(GSYSTEM_TICKLESS_IDLE)
+    #undef GSYSTEM_TICKLESS_IDLE
 #endif
-#ifndef GSYSTEM_NO_DEVICE_SETTINGS
-    #define __GC_CNT_SETTINGS (1)
-#else
-    #define __GC_CNT_SETTINGS (0)
+
+#if defined(GSYSTEM_TICKLESS_IDLE) && !defined(GSYSTEM_TIMER)
+    #error "GSYSTEM_TICKLESS_IDLE requires GSYSTEM_TIMER"
 #endif
 
-#define GSYSTEM_MIN_PROCCESS_CNT \
-    (4 + __GC_CNT_MEMORY + __GC_CNT_SYS_TICK + __GC_CNT_RAM + __GC_CNT_ADC + __GC_CNT_I2C + __GC_CNT_POWER + __GC_CNT_RTC + __GC_CNT_SETTINGS)
+#if defined(GSYSTEM_DWT_MICROS) && !defined(GSYSTEM_TIMER)
+    #error "GSYSTEM_DWT_MICROS requires GSYSTEM_TIMER"
+#endif
+
+#ifndef GSYSTEM_COLOR_DEFAULT
+	#define GSYSTEM_COLOR_DEFAULT "\x1b[0m"
+#endif
+#ifndef GSYSTEM_COLOR_ERROR
+    #define GSYSTEM_COLOR_ERROR   "\x1b[31m"
+#endif
+#ifndef GSYSTEM_COLOR_SUCCESS
+    #define GSYSTEM_COLOR_SUCCESS "\x1b[32m"
+#endif
+#ifndef GSYSTEM_COLOR_WARN
+    #define GSYSTEM_COLOR_WARN    "\x1b[33m"
+#endif
 
 
 #ifdef __cplusplus
@@ -61,7 +61,8 @@ uint16_t SYSTEM_ADC_VOLTAGE[GSYSTEM_ADC_VOLTAGE_COUNT] = {0};
 #endif
 
 static bool sys_timer_rdy = false;
-uint32_t sys_time_ms = 0;
+volatile uint32_t sys_time_ms = 0;
+volatile uint32_t sys_time_ms_half = 0;
 
 static bool system_timer_callback_flag = false;
 void _system_timer_callback(void)
@@ -79,12 +80,15 @@ extern bool __internal_set_clock_ram(const uint8_t idx, uint8_t data);
 
 extern void sys_isr_register();
 extern void sys_fill_ram();
+extern void sys_soul_log_init();
 void system_init(void)
 {
     sys_isr_register();
 
     sys_fill_ram();
 
+    sys_soul_log_init();
+
 	if (!gversion_from_string(BUILD_VERSION, strlen(BUILD_VERSION), &build_ver)) {
 		memset((void*)&build_ver, 0, sizeof(build_ver));
 	}
@@ -305,15 +309,10 @@ void system_start(void)
 
     while (1) {
         system_tick();
+        system_idle();
     }
 }
 
-void system_reset(void)
-{
-    system_before_reset();
-    g_reboot();
-}
-
 bool is_system_ready()
 {
     return !(has_errors() || is_status(SYSTEM_SAFETY_MODE) || !is_status(SYSTEM_HARDWARE_READY) || !is_status(SYSTEM_SOFTWARE_READY));
@@ -347,7 +346,7 @@ void system_error_handler(SOUL_STATUS error)
 
     if (!has_mcu_internal_error) {
         if (is_soul_bedug_enable() && !is_error(POWER_ERROR)) {
-            SYSTEM_BEDUG("GSystem_error_handler called error=%s", get_status_name(error));
+            SYSTEM_BEDUG("GSystem_error_handler called error=" SOUL_STATUS_FMT, SOUL_STATUS_ARG(error));
         } else if (!is_error(POWER_ERROR)) {
             SYSTEM_BEDUG("GSystem_error_handler called error=%u", error);
         }
@@ -413,36 +412,23 @@ void system_error_handler(SOUL_STATUS error)
         g_reboot();
     }
 
-    uint32_t delay_ms = GSYSTEM_RESET_TIMEOUT_MS;
-    gtimer_t timer = {0};
-    system_timer_t s_timer = {0};
-    if (need_error_timer) {
-        system_timer_start(&s_timer, delay_ms);
-    } else {
-        gtimer_start(&timer, delay_ms);
-    }
-    while(1) {
+    // The other jobs keep running until the reset
+    for (uint32_t waited_ms = 0; waited_ms < GSYSTEM_RESET_TIMEOUT_MS; waited_ms++) {
         system_error_loop();
 
-        system_tick();
-
         if (need_error_timer) {
-            if (!system_timer_wait(&s_timer)) break;
-        } else if (!gtimer_wait(&timer)) {
-            break;
+            // Masked interrupts: the delay below only spins, the jobs are launched here
+            system_tick();
         }
-    }
-    if (need_error_timer) {
-        system_timer_stop(&s_timer);
+        system_yield_delay_ms(1);
     }
 
     system_before_reset();
 
 #if GSYSTEM_BEDUG
-    system_timer_start(&s_timer, SECOND_MS);
     SYSTEM_BEDUG("GSystem reset\n\n\n");
-    while(system_timer_wait(&s_timer));
-    system_timer_stop(&s_timer);
+    // Nothing else runs after system_before_reset(): the log output only
+    system_delay_us((uint64_t)SECOND_MS * MILLIS_US);
 #endif
 
     g_reboot();
@@ -450,35 +436,6 @@ void system_error_handler(SOUL_STATUS error)
 
 __attribute__((weak)) void system_before_reset(void) {}
 
-void system_timer_start(system_timer_t* timer, uint32_t delay_ms)
-{
-    if (!timer) {
-        BEDUG_ASSERT(false, "Timer must not be NULL");
-        return;
-    }
-    timer->started  = 1;
-    timer->delay_ms = delay_ms;
-    timer->start_ms = system_millis();
-}
-
-bool system_timer_wait(const system_timer_t* timer)
-{
-    if (!timer) {
-        BEDUG_ASSERT(false, "Timer must not be NULL");
-        return false;
-    }
-    return timer->started && timer->start_ms + timer->delay_ms < system_millis();
-}
-
-void system_timer_stop(system_timer_t* timer)
-{
-    if (!timer) {
-        BEDUG_ASSERT(false, "Timer must not be NULL");
-        return;
-    }
-    timer->started = false;
-}
-
 bool system_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t cnt)
 {
     if (!timer || !callback) {
@@ -805,21 +762,19 @@ void system_sys_tick_reanimation(void)
 
     RCC->CIR |= RCC_CIR_CSSC;
 
-    system_timer_t timer = {0};
-    system_timer_start(&timer, 5 * SECOND_MS);
-    while (system_timer_wait(&timer));
-    system_timer_stop(&timer);
+    // Masked interrupts: the waits fall back to the cycle counted delay
+    const uint32_t HSE_TIMEOUT_MS = 5 * SECOND_MS;
+    system_yield_delay_ms(HSE_TIMEOUT_MS);
 
     RCC->CR |= RCC_CR_HSEON;
-    system_timer_start(&timer, 5 * SECOND_MS);
-    while (system_timer_wait(&timer)) {
+    for (uint32_t waited_ms = 0; waited_ms < HSE_TIMEOUT_MS; waited_ms++) {
         if (RCC->CR & RCC_CR_HSERDY) {
             reset_error(SYS_TICK_FAULT);
             reset_error(SYS_TICK_ERROR);
             break;
         }
+        system_yield_delay_ms(1);
     }
-    system_timer_stop(&timer);
 
 
     if (is_error(SYS_TICK_ERROR)) {
@@ -884,8 +839,11 @@ bool set_system_bckp(const uint8_t idx, const uint8_t data)
 
 void system_delay_us(uint64_t us)
 {
-    uint64_t start = getMicroseconds();
-    while (start + us > getMicroseconds());
+    while (us > UINT32_MAX) {
+        g_delay_us(UINT32_MAX);
+        us -= UINT32_MAX;
+    }
+    g_delay_us((uint32_t)us);
 }
 
 void system_set_print_color(const char* color)
@@ -930,6 +888,22 @@ uint64_t system_micros()
     return getMicroseconds();
 }
 
+uint64_t system_nanos()
+{
+    if (sys_timer_rdy) {
+        return g_get_nanos();
+    }
+    return getMicroseconds() * 1000;
+}
+
+uint64_t system_millis64()
+{
+    if (sys_timer_rdy) {
+        return g_get_millis64();
+    }
+    return (uint64_t)getMillis();
+}
+
 uint32_t system_millis()
 {
     if (sys_timer_rdy) {
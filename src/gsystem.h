@@ -37,10 +37,8 @@ extern "C" {
  * 1. Add versioning for the library.
  * 2. Show version in the logs, error logs, and device revision debug, save it to system files.
  * 3. TODO list in soul.h
- * 4. Add Publisher-subscriber (and its broker) pattern for system events (errors, resets, button events, periphm etc.).
- * 5. Add MVC pattern for system services and tasks.
- * 6. Platform driver disable in gconfig.h for user driver implementations.
- * 7. Add system services and tasks management API (start, stop, restart, status).
+ * 4. Add MVC pattern for system services and tasks.
+ * 5. Platform driver disable in gconfig.h for user driver implementations.
  */
 #define GSYSTEM_VERSION 1
 
@@ -60,6 +58,165 @@ extern "C" {
 extern const uint32_t TIMER_VERIF_WORD; // TODO
 
 
+/*
+ * System event topics for system_event_publish() and GSYSTEM_EVENT_SUBSCRIBERS.
+ * Project topics start from GSYS_EVENT_USER.
+ */
+typedef enum _gsys_event_topic_t {
+    GSYS_EVENT_STATUS     = 0,      // value - SOUL_STATUS, arg - 1 if set / 0 if reset
+    GSYS_EVENT_ERROR,               // value - SOUL_STATUS, arg - 1 if set / 0 if reset
+    GSYS_EVENT_BUTTON,              // value - gsys_button_event_t, arg - clicks, data - const port_pin_t*
+    GSYS_EVENT_RESET,               // system_reset() was called, delivered before the reset
+    GSYS_EVENT_USER       = 32,
+    GSYS_EVENT_TOPIC_NONE = 0xFFFF
+} gsys_event_topic_t;
+
+/*
+ * Scheduler job handle returned by the system_register*() functions.
+ * The handle stays valid until the job is removed, stale handles of
+ * removed jobs are rejected even if the job slot is reused.
+ */
+typedef uint32_t gsys_job_t;
+
+#define GSYS_JOB_INVALID ((gsys_job_t)0)
+
+typedef enum _gsys_button_event_t {
+    GSYS_BUTTON_PRESSED = 0,
+    GSYS_BUTTON_CLICKED,
+    GSYS_BUTTON_HELD,
+    GSYS_BUTTON_RELEASED
+} gsys_button_event_t;
+
+/*
+ * Job latency percentiles from the log2 histograms (GSYSTEM_PROC_HISTOGRAM).
+ * Values are the upper bounds of the histogram buckets.
+ */
+typedef struct _gsys_job_latency_t {
+    uint32_t exec_p50_us;
+    uint32_t exec_p99_us;
+    uint32_t exec_p999_us;
+    uint32_t jitter_p50_us;   // Start time minus due time
+    uint32_t jitter_p99_us;
+    uint32_t jitter_p999_us;
+} gsys_job_latency_t;
+
+/*
+ * Scheduler job statistics, see system_get_job_stats().
+ */
+typedef struct _gsys_job_stats_t {
+    uint32_t action;               // Job function address
+    uint32_t period_ms;            // Registered period
+    uint32_t effective_period_ms;  // Period after the adaptive scaling
+    uint32_t period_us;            // Effective period in us (ISR job period)
+    uint32_t load_x100;            // CPU load in % x100
+    uint32_t average_us;           // Average execution time
+    uint32_t max_exec_us;          // Max execution time since the last status print
+    uint32_t exec_counter;         // Launches per second
+    uint32_t scale_x100;           // Period scale in % x100
+    uint32_t overruns;             // Missed ISR job periods
+    uint32_t wcet_us;              // EDF job WCET budget
+    uint32_t deadline_us;          // EDF job relative deadline
+    uint32_t deadline_misses;      // EDF job deadline misses
+    uint8_t  priority;
+    bool     realtime;
+    bool     isr;
+} gsys_job_stats_t;
+
+/*
+ * Scheduler statistics, see system_get_scheduler_stats().
+ */
+typedef struct _gsys_scheduler_stats_t {
+    uint32_t jobs_count;
+    uint32_t total_load_x100;      // Main loop jobs CPU load in % x100
+    uint32_t isr_load_x100;        // ISR jobs CPU load in % x100
+    uint32_t target_load_x100;     // Adaptive scaling target load in % x100
+    uint32_t jobs_scale_x100;      // Common period scale in % x100
+    uint32_t ticks_per_second;     // system_tick() calls per second
+    uint32_t isr_budget_hits;      // ISR passes stopped by GSYSTEM_ISR_BUDGET_US
+    uint32_t edf_load_x100;        // Admitted EDF jobs utilization in % x100
+    uint32_t pass_overhead_ns;     // Average system_tick() pass cost without the jobs (0 with GSYSTEM_NO_PROC_INFO)
+    uint32_t jobs_ram_bytes;       // RAM of the job table and the queues
+    uint32_t stats_ram_bytes;      // RAM of the job statistics
+} gsys_scheduler_stats_t;
+
+/*
+ * Event delivered by reference to subscribers. The event memory belongs to the
+ * broker pool and is valid only during the subscriber call.
+ */
+typedef struct _gsys_event_t {
+    uint16_t    topic;
+    uint32_t    value;
+    uint32_t    arg;
+    const void* data;
+} gsys_event_t;
+
+/*
+ * Callback soft timer of the timing wheel (GSYSTEM_TIMER_WHEEL).
+ * The memory belongs to the caller and must stay valid while the timer is
+ * active, zero initialize the timer before the first start.
+ */
+typedef struct _gsys_wtimer_t {
+    struct _gsys_wtimer_t*  next;
+    struct _gsys_wtimer_t** pprev;     // NULL - the timer is not active
+    uint64_t                expire_ms;
+    uint32_t                period_ms; // 0 - one shot timer
+    void                    (*callback)(void*);
+    void*                   arg;
+} gsys_wtimer_t;
+
+/*
+ * High-resolution one-shot timer (GSYSTEM_HRT_TIMER).
+ * The memory belongs to the caller and must stay valid while the timer is
+ * pending, zero initialize the timer before the first start.
+ */
+typedef struct _gsys_hrt_t {
+    struct _gsys_hrt_t* next;
+    uint32_t            deadline_us;
+    void                (*callback)(void*);
+    void*               arg;
+    bool                pending;
+} gsys_hrt_t;
+
+/*
+ * Soul flight recorder record (GSYSTEM_SOUL_LOG): one status or error transition.
+ */
+typedef struct _gsys_soul_record_t {
+    uint32_t time_ms; // system_millis() of the boot the record belongs to
+    uint8_t  status;  // SOUL_STATUS
+    uint8_t  flags;   // Bit 0 - set (1) or reset (0), bits 1-7 - boot counter (GSYS_SOUL_RECORD_BOOT)
+    uint16_t check;
+} gsys_soul_record_t;
+
+#define GSYS_SOUL_RECORD_SET(RECORD)  ((bool)((RECORD)->flags & 0x01))
+#define GSYS_SOUL_RECORD_BOOT(RECORD) ((uint8_t)((RECORD)->flags >> 1))
+
+/*
+ * Fault crash dump (GSYSTEM_CRASH_DUMP) captured by the fault handlers and kept over the reset.
+ */
+typedef struct _gsys_crash_dump_t {
+    uint32_t fault;       // SOUL_STATUS of the fault vector (HARD_FAULT, BUS_FAULT, ...)
+    uint32_t r0;          // Stacked exception frame
+    uint32_t r1;
+    uint32_t r2;
+    uint32_t r3;
+    uint32_t r12;
+    uint32_t lr;
+    uint32_t pc;
+    uint32_t xpsr;
+    uint32_t exc_return;
+    uint32_t sp;          // Exception frame address (MSP or PSP)
+    uint32_t cfsr;        // Fault status registers
+    uint32_t hfsr;
+    uint32_t mmfar;
+    uint32_t bfar;
+    uint32_t time_ms;     // system_millis() at the fault
+    uint8_t  job_id;      // Running scheduler job, 0xFF - none
+    uint8_t  stack_words; // Valid words in stack[]
+    uint16_t reserved;
+    uint32_t stack[GSYSTEM_CRASH_STACK_WORDS]; // Stack above the exception frame
+} gsys_crash_dump_t;
+
+
 /*
  * @brief Initialize core system subsystems and hardware abstractions. Use it at start of main().
  * @param None
@@ -75,10 +232,10 @@ void system_init(void);
  * @param realtime (bool) - If true, the task is treated as realtime priority and won't be optimized by the scheduler.
  * @param work_with_error (bool) - If true, the task will run even if system has errors.
  * @param priority (uint32_t) - Relative task priority. Used for scheduling decisions.
- * @return None
- * @example system_register(my_task, 1000, false, true, 100);
+ * @return gsys_job_t - Job handle, GSYS_JOB_INVALID if the task wasn't registered
+ * @example gsys_job_t job = system_register(my_task, 1000, false, true, 100);
  */
-void system_register(
+gsys_job_t system_register(
     void (*task) (void),
     uint32_t delay_ms,
     bool realtime,
@@ -87,17 +244,55 @@ void system_register(
 );
 
 /*
- * @brief Register a task to be executed in ISR context or with ISR-like timing.
+ * @brief Pin the launch phase of the registered main-loop task.
+ *        By default the scheduler spreads tasks with equal or harmonic periods
+ *        across the period automatically; the pinned phase is counted from the
+ *        system time aligned to the task period.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @param phase_ms (uint32_t) - Phase offset in milliseconds (modulo the period).
+ * @return false if the handle is invalid or stale or the job is an ISR job
+ * @example gsys_job_t log_job = system_register(log_task, 1000, false, false, 100); system_job_set_phase(log_job, 500);
+ */
+bool system_job_set_phase(gsys_job_t handle, uint32_t phase_ms);
+
+/*
+ * @brief Register a periodic task with a WCET budget and a deadline (GSYSTEM_SCHEDULER_EDF).
+ *        The task is admitted only if the sum of WCET / min(deadline, period) of all
+ *        such tasks stays within GSYSTEM_EDF_MAX_LOAD_X100. Released tasks are launched
+ *        in earliest-deadline-first order before the other main-loop tasks, periods
+ *        are absolute and deadline misses are counted (see system_get_job_stats()).
+ * @note Main-loop tasks aren't preempted: the longest task execution time must fit
+ *       into the load reserve left by GSYSTEM_EDF_MAX_LOAD_X100.
+ * @param task (void (*)(void)) - Function pointer to the task to be called.
+ * @param period_ms (uint32_t) - Release period in milliseconds.
+ * @param wcet_us (uint32_t) - Worst case execution time in microseconds.
+ * @param deadline_ms (uint32_t) - Relative deadline in milliseconds (0 - equal to the period).
+ * @param work_with_error (bool) - If true, the task will run even if system has errors.
+ * @return gsys_job_t - Job handle, GSYS_JOB_INVALID if the task set isn't schedulable with the task or EDF mode is disabled
+ * @example if (!system_register_rt(motor_loop, 1, 150, 1, true)) { ... }
+ */
+gsys_job_t system_register_rt(
+    void (*task) (void),
+    uint32_t period_ms,
+    uint32_t wcet_us,
+    uint32_t deadline_ms,
+    bool work_with_error
+);
+
+/*
+ * @brief Register a task to be executed in ISR context.
+ *        ISR tasks are launched from the GSYSTEM_ISR_TIMER update interrupt
+ *        (or from system_tick_isr() if the timer is not defined) at absolute
+ *        period boundaries and are never scaled by the scheduler.
  * @param task (void (*)(void)) - Function pointer to the ISR-context task.
  * @param delay_ms (uint32_t) - Delay in milliseconds between launches.
- * @param realtime (bool) - If true, the task is treated as realtime priority and won't be optimized by the scheduler.
+ * @param realtime (bool) - Unused: ISR tasks are always realtime.
  * @param work_with_error (bool) - If true, the task will run even if system has errors.
  * @param priority (uint32_t) - Relative task priority.
- * @return None
+ * @return gsys_job_t - Job handle, GSYS_JOB_INVALID if the task wasn't registered
  * @example system_register_isr(my_task, 1000, false, true, 100);
- * TODO: the sheduler is not implemented yet
  */
-void system_register_isr(
+gsys_job_t system_register_isr(
     void (*task) (void),
     uint32_t delay_ms,
     bool realtime,
@@ -105,6 +300,190 @@ void system_register_isr(
     uint32_t priority
 );
 
+/*
+ * @brief Register a task to be executed in ISR context with a microsecond period.
+ *        The job stats report the period rounded up to milliseconds in period_ms
+ *        (1 ms for the sub-millisecond periods) and the exact one in period_us.
+ * @param task (void (*)(void)) - Function pointer to the ISR-context task.
+ * @param period_us (uint32_t) - Period in microseconds between launches (down to ~100 us).
+ * @param work_with_error (bool) - If true, the task will run even if system has errors.
+ * @return gsys_job_t - Job handle, GSYS_JOB_INVALID if the task wasn't registered
+ * @example system_register_isr_us(sample_sensor, 100, true);
+ */
+gsys_job_t system_register_isr_us(
+    void (*task) (void),
+    uint32_t period_us,
+    bool work_with_error
+);
+
+/*
+ * @brief Suspend the registered job. A suspended job is taken out of the
+ *        scheduler queues and costs nothing per tick until it is resumed.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @return false if the handle is invalid or stale
+ * @example system_job_suspend(log_job);
+ */
+bool system_job_suspend(gsys_job_t handle);
+
+/*
+ * @brief Resume the suspended job, the next launch is one period later.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @return false if the handle is invalid or stale
+ * @example system_job_resume(log_job);
+ */
+bool system_job_resume(gsys_job_t handle);
+
+/*
+ * @brief Check if the job is suspended.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @return true if the job exists and is suspended
+ */
+bool system_job_is_suspended(gsys_job_t handle);
+
+/*
+ * @brief Unregister the job. Its slot is reused by the next registration,
+ *        the handle becomes stale. A job may remove itself from its task.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @return false if the handle is invalid or stale
+ * @example system_job_remove(log_job); log_job = GSYS_JOB_INVALID;
+ */
+bool system_job_remove(gsys_job_t handle);
+
+/*
+ * @brief Change the job period at runtime.
+ * @note The EDF job period change is subject to the admission test.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @param period_ms (uint32_t) - New period in milliseconds.
+ * @return false if the handle is invalid or stale or the EDF job isn't schedulable with the period
+ * @example system_job_set_period(log_job, 5000);
+ */
+bool system_job_set_period(gsys_job_t handle, uint32_t period_ms);
+
+/*
+ * @brief Change the job relative priority used by the adaptive scaling.
+ *        Of the jobs due at the same time the lower priority value runs first.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @param priority (uint32_t) - New priority.
+ * @return false if the handle is invalid or stale
+ * @example system_job_set_priority(log_job, 200);
+ */
+bool system_job_set_priority(gsys_job_t handle, uint32_t priority);
+
+/*
+ * @brief Defer work from an interrupt handler to the main loop.
+ *        Lock-free and safe from any interrupt priority, the posted callbacks
+ *        are called by system_tick() before the periodic jobs in FIFO order.
+ * @param fn (void (*)(void*)) - Callback to be called from the main loop.
+ * @param arg (void*) - Callback argument.
+ * @return true if posted, false if the queue is full (GSYSTEM_POST_QUEUE_SIZE)
+ * @example system_post(handle_rx, &rx_buffer);
+ */
+bool system_post(void (*fn)(void*), void* arg);
+
+/*
+ * @brief Publish a system event to the compile-time subscribers (GSYSTEM_EVENT_SUBSCRIBERS).
+ *        The event is stored in the broker pool and delivered from system_tick(),
+ *        can be called from interrupt handlers.
+ * @param topic (uint16_t) - Event topic (gsys_event_topic_t or project topic from GSYS_EVENT_USER).
+ * @param value (uint32_t) - Topic specific value.
+ * @param arg (uint32_t) - Topic specific argument.
+ * @param data (const void*) - Topic specific data, must stay valid until the delivery.
+ * @return false if the event pool or the system_post() queue is full
+ * @example system_event_publish(GSYS_EVENT_USER, MY_EVENT_RX, len, rx_buf);
+ */
+bool system_event_publish(uint16_t topic, uint32_t value, uint32_t arg, const void* data);
+
+/*
+ * @brief Read execution time and start jitter percentiles of the job (GSYSTEM_PROC_HISTOGRAM).
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @param latency (gsys_job_latency_t*) - Result.
+ * @return false if the handle is invalid or stale or the histograms are disabled
+ * @example gsys_job_latency_t lat; if (system_job_latency(log_job, &lat)) printf("%lu", lat.exec_p99_us);
+ */
+bool system_job_latency(gsys_job_t handle, gsys_job_latency_t* latency);
+
+/*
+ * @brief Reset the latency histograms of the job (GSYSTEM_PROC_HISTOGRAM).
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @return None
+ */
+void system_job_latency_reset(gsys_job_t handle);
+
+/*
+ * @brief Read statistics of the scheduler job.
+ * @param handle (gsys_job_t) - Job handle from system_register*().
+ * @param stats (gsys_job_stats_t*) - Result.
+ * @return false if the handle is invalid or stale
+ * @example gsys_job_stats_t stats; if (system_get_job_stats(log_job, &stats)) printf("%lu", stats.load_x100);
+ */
+bool system_get_job_stats(gsys_job_t handle, gsys_job_stats_t* stats);
+
+/*
+ * @brief Read common scheduler statistics.
+ * @param stats (gsys_scheduler_stats_t*) - Result.
+ * @return false if stats is NULL
+ */
+bool system_get_scheduler_stats(gsys_scheduler_stats_t* stats);
+
+/*
+ * @brief Write a compact binary snapshot of the scheduler and job statistics
+ *        ("GSTS" magic, packed little endian records, see g_proc.cpp).
+ * @param buf (uint8_t*) - Destination buffer, NULL - return the required size.
+ * @param size (uint32_t) - Destination buffer size.
+ * @return Snapshot size in bytes, 0 if the buffer is too small
+ * @example uint8_t buf[512]; uint32_t len = system_stats_snapshot(buf, sizeof(buf));
+ */
+uint32_t system_stats_snapshot(uint8_t* buf, uint32_t size);
+
+/*
+ * @brief Dump the scheduler trace ring buffer (GSYSTEM_TRACE) in binary format.
+ *        Convert the dump with tools/gtrace2chrome.py to Chrome trace JSON.
+ * @param write (void (*)(const uint8_t*, uint32_t)) - Dump writer (e.g. storage write),
+ *        NULL - write to the debug UART.
+ * @return None
+ * @example system_trace_dump(NULL);
+ */
+void system_trace_dump(void (*write)(const uint8_t* data, uint32_t len));
+
+/*
+ * @brief Drop all records of the scheduler trace ring buffer (GSYSTEM_TRACE).
+ * @param None
+ * @return None
+ */
+void system_trace_clear(void);
+
+/*
+ * @brief Number of soul transition records in the flight recorder RAM ring (GSYSTEM_SOUL_LOG),
+ *        including the records recovered after a warm reset.
+ * @param None
+ * @return uint32_t - Records count, at most GSYSTEM_SOUL_LOG_SIZE.
+ */
+uint32_t system_soul_log_count(void);
+
+/*
+ * @brief Read a soul transition record from the flight recorder RAM ring (GSYSTEM_SOUL_LOG).
+ * @param index (uint32_t) - Record index, 0 - the newest record.
+ * @param record (gsys_soul_record_t*) - Destination record.
+ * @return false if there is no such record or the record is damaged
+ * @example gsys_soul_record_t rec; if (system_soul_log_get(0, &rec)) { ... }
+ */
+bool system_soul_log_get(uint32_t index, gsys_soul_record_t* record);
+
+/*
+ * @brief Get the fault crash dump recovered after the reset (GSYSTEM_CRASH_DUMP).
+ * @param dump (gsys_crash_dump_t*) - Destination dump.
+ * @return false if there is no valid dump
+ * @example gsys_crash_dump_t dump; if (system_crash_dump_get(&dump)) { report(dump.pc); }
+ */
+bool system_crash_dump_get(gsys_crash_dump_t* dump);
+
+/*
+ * @brief Drop the recovered fault crash dump (GSYSTEM_CRASH_DUMP).
+ * @param None
+ * @return None
+ */
+void system_crash_dump_clear(void);
+
 /*
  * @brief Set a global system error timeout used by watchdog-like operations.
  *        If runtime has error statuses for longer than `timeout_ms`, the system error handler 
@@ -153,6 +532,15 @@ void system_post_load(void);
  */
 void system_tick(void);
 
+/*
+ * @brief Sleep the MCU until the nearest job deadline (GSYSTEM_TICKLESS_IDLE).
+ *        Does nothing if tickless idle is disabled.
+ * @param None
+ * @return None
+ * @example { while (1) { system_tick(); system_idle(); } }
+ */
+void system_idle(void);
+
 /*
  * @brief System tick handler intended for ISR context. 
  *        Calls in the interrupt.
@@ -260,10 +648,74 @@ bool system_timer_wait(const system_timer_t* timer);
  */
 void system_timer_stop(system_timer_t* timer);
 
+/*
+ * @brief Start (or restart) a callback soft timer of the timing wheel (GSYSTEM_TIMER_WHEEL).
+ *        O(1) start, the callback is called from system_tick() on expiry.
+ *        Use it from the main loop context only (jobs, system_post() callbacks).
+ * @param timer (gsys_wtimer_t*) - Caller-owned timer, must stay valid while active.
+ * @param delay_ms (uint32_t) - Delay in milliseconds before the first expiry.
+ * @param period_ms (uint32_t) - Period of the following expiries, 0 - one shot.
+ * @param callback (void (*)(void*)) - Expiry callback.
+ * @param arg (void*) - Callback argument.
+ * @return false if the arguments are invalid or GSYSTEM_TIMER_WHEEL is not defined
+ * @example static gsys_wtimer_t led_timer = {}; system_wtimer_start(&led_timer, 0, 500, led_toggle, NULL);
+ */
+bool system_wtimer_start(gsys_wtimer_t* timer, uint32_t delay_ms, uint32_t period_ms, void (*callback)(void*), void* arg);
+
+/*
+ * @brief Stop a callback soft timer of the timing wheel in O(1), can be called from its callback.
+ * @param timer (gsys_wtimer_t*) - Timer to stop.
+ * @return None
+ */
+void system_wtimer_stop(gsys_wtimer_t* timer);
+
+/*
+ * @brief Check if a callback soft timer of the timing wheel is waiting for expiry.
+ * @param timer (const gsys_wtimer_t*) - Timer to check.
+ * @return bool - true if the timer is started.
+ */
+bool system_wtimer_active(const gsys_wtimer_t* timer);
+
+/*
+ * @brief Start (or restart) a high-resolution one-shot timer multiplexed on GSYSTEM_HRT_TIMER.
+ *        The callback is called from the timer interrupt (GSYSTEM_HRT_TIMER_PRIO) with 1 us
+ *        resolution. Can be called from any context, including the callback.
+ * @param timer (gsys_hrt_t*) - Caller-owned timer, must stay valid while pending.
+ * @param delay_us (uint32_t) - Delay in microseconds (max 2^31 - 1).
+ * @param callback (void (*)(void*)) - Expiry callback.
+ * @param arg (void*) - Callback argument.
+ * @return false if the arguments are invalid, the timer can't be started or GSYSTEM_HRT_TIMER is not defined
+ * @example static gsys_hrt_t rx_timeout = {}; system_hrt_start(&rx_timeout, 350, modbus_frame_end, NULL);
+ */
+bool system_hrt_start(gsys_hrt_t* timer, uint32_t delay_us, void (*callback)(void*), void* arg);
+
+/*
+ * @brief Cancel a pending high-resolution timer.
+ * @param timer (gsys_hrt_t*) - Timer to cancel.
+ * @return None
+ */
+void system_hrt_stop(gsys_hrt_t* timer);
+
+/*
+ * @brief Check if a high-resolution timer is waiting for its deadline.
+ * @param timer (const gsys_hrt_t*) - Timer to check.
+ * @return bool - true if the timer is pending.
+ */
+bool system_hrt_pending(const gsys_hrt_t* timer);
+
 bool system_hw_timer_start(hard_tim_t* timer, void (*callback) (void), uint32_t presc, uint32_t cnt);
 
 void system_hw_timer_stop(hard_tim_t* timer);
 
+/*
+ * @brief Number of hardware timers not claimed by the gsystem timer API
+ *        (system timer, ISR timer, HRT timer, system_hw_timer_start()).
+ *        Timers configured directly through the vendor HAL are not tracked.
+ * @param None
+ * @return uint32_t - Unclaimed hardware timers count.
+ */
+uint32_t system_hw_timers_unclaimed(void);
+
 /*
  * @brief Register a button pin to be handled by the system button subsystem.
  * @note If you need to realize more complex button logic, 
@@ -421,21 +873,62 @@ uint32_t get_system_freq(void);
 
 /*
  * @brief Busy-wait delay for the specified number of microseconds.
+ *        Counts CPU cycles (DWT) where available, nothing else runs during the wait.
  * @param us (uint64_t) - Microseconds to delay.
  * @return None
  */
 void system_delay_us(uint64_t us);
 
+/*
+ * @brief Cooperative delay: run system_tick() passes (the other due jobs, posted
+ *        callbacks, timer wheel) until the time is over. The calling job is not
+ *        launched again during its own wait. Nested yields, interrupt handlers,
+ *        masked interrupts and waits shorter than GSYSTEM_YIELD_MIN_US fall back
+ *        to system_delay_us().
+ * @note The delay may end later than requested by the longest launched job.
+ * @param us (uint64_t) - Microseconds to delay.
+ * @return None
+ * @example system_yield_delay_us(500); // wait for the sensor conversion
+ */
+void system_yield_delay_us(uint64_t us);
+
+/*
+ * @brief Cooperative delay in milliseconds, see system_yield_delay_us().
+ * @param ms (uint32_t) - Milliseconds to delay.
+ * @return None
+ */
+void system_yield_delay_ms(uint32_t ms);
+
 void system_set_print_color(const char* color);
 
 void system_print_clear();
 
 void SYSTEM_BEDUG(const char* format, ...);
 
+/*
+ * @brief Monotonic system time in microseconds. Lock-free: interrupts are
+ *        not masked, the read is retried if the system tick changes during it.
+ */
 uint64_t system_micros();
 
+/*
+ * @brief Monotonic system time in nanoseconds. The resolution is one CPU
+ *        cycle with GSYSTEM_DWT_MICROS, otherwise one microsecond.
+ */
+uint64_t system_nanos();
+
+/*
+ * @brief System time in milliseconds, the cheap 32-bit view of system_millis64().
+ *        It wraps every ~49.7 days: compare the times by the difference
+ *        ((uint32_t)(now - start) >= delay), not by the sum.
+ */
 uint32_t system_millis();
 
+/*
+ * @brief Monotonic 64-bit system time in milliseconds, doesn't wrap.
+ */
+uint64_t system_millis64();
+
 
 #if defined(ARDUINO) && !defined(GSYSTEM_NO_VTOR_REWRITE)
 
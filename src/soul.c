@@ -42,9 +42,23 @@ typedef enum _type_t {
 } type_t;
 
 
+#define SOUL_WORD_BITS (32)
+#define SOUL_WORDS     (__div_up(SOUL_STATUSES_END, SOUL_WORD_BITS))
+
+/* @brief Bits [0, N) of the bitmap word W */
+#define SOUL_BITS_BELOW(W, N)                                   \
+	((N) <= (W) * SOUL_WORD_BITS ? 0u :                         \
+	 (N) >= ((W) + 1) * SOUL_WORD_BITS ? 0xFFFFFFFFu :           \
+	 ((1u << (((N) - (W) * SOUL_WORD_BITS) & 31)) - 1u))
+
+/* @brief Bits [LO, HI) of the bitmap word W, folded to a constant for constant arguments */
+#define SOUL_RANGE_MASK(W, LO, HI) (SOUL_BITS_BELOW(W, HI) & ~SOUL_BITS_BELOW(W, LO))
+
+
 /* 
  * @brief Internal bitmap holding status flags and last error struct. Not exposed outside
- *        this file. The layout uses a compact bitset for storage efficiency. 
+ *        this file. The layout uses a compact bitset of 32-bit words, so range checks
+ *        are done a word at a time.
  */
 typedef struct _soul_t {
 #if defined(__G_SOUL_BEDUG)
@@ -52,7 +66,7 @@ typedef struct _soul_t {
 	bool has_new_status_data;
 #endif
 	SOUL_STATUS last_err;
-	uint8_t statuses[__div_up(SOUL_STATUSES_END, BITS_IN_BYTE)];
+	volatile uint32_t statuses[SOUL_WORDS];
 } soul_t;
 
 
@@ -66,16 +80,28 @@ static soul_t soul = {
 };
 
 
+/* @brief Bumped on every status or error bit change, see get_soul_generation(). */
+static volatile uint32_t soul_generation = 0;
+
+
 /* @brief Fallback name returned for unknown statuses when no custom name is set. */
 const char *SOUL_UNKNOWN_STATUS = "UNKNOWN_STATUS";
 
 
 bool _is_status(SOUL_STATUS status);
-void _set_status(SOUL_STATUS status);
-void _reset_status(SOUL_STATUS status);
+bool _set_status(SOUL_STATUS status);
+bool _reset_status(SOUL_STATUS status);
 void _show_not_status(type_t type, SOUL_STATUS status, unsigned line);
+static SOUL_STATUS _first_in_range(unsigned lo, unsigned hi);
+
+extern void sys_soul_log_append(SOUL_STATUS status, bool set);
 
 
+uint32_t get_soul_generation()
+{
+	return soul_generation;
+}
+
 SOUL_STATUS get_last_error()
 {
 	return soul.last_err;
@@ -90,8 +116,8 @@ void set_last_error(SOUL_STATUS error)
 
 bool has_errors()
 {
-	for (unsigned i = ERRORS_START + 1; i < ERRORS_END; i++) {
-		if (_is_status((SOUL_STATUS)(i))) {
+	for (unsigned w = (ERRORS_START + 1) / SOUL_WORD_BITS; w <= (ERRORS_END - 1) / SOUL_WORD_BITS; w++) {
+		if (soul.statuses[w] & SOUL_RANGE_MASK(w, ERRORS_START + 1, ERRORS_END)) {
 			return true;
 		}
 	}
@@ -110,12 +136,12 @@ bool is_internal_error(SOUL_STATUS error)
 void set_internal_error(SOUL_STATUS error)
 {
 	if (error > ERRORS_START && error < ERRORS_END) {
+		if (_set_status(error)) {
 #if defined(__G_SOUL_BEDUG)
-		if (!_is_status(error)) {
 			soul.has_new_error_data = true;
-		}
 #endif
-		_set_status(error);
+			system_event_publish(GSYS_EVENT_ERROR, error, true, NULL);
+		}
 	} else {
 		_show_not_status(TYPE_ERROR, error, __LINE__);
 	}
@@ -124,12 +150,12 @@ void set_internal_error(SOUL_STATUS error)
 void reset_internal_error(SOUL_STATUS error)
 {
 	if (error > ERRORS_START && error < ERRORS_END) {
+		if (_reset_status(error)) {
 #if defined(__G_SOUL_BEDUG)
-		if (_is_status(error)) {
 			soul.has_new_error_data = true;
-		}
 #endif
-		_reset_status(error);
+			system_event_publish(GSYS_EVENT_ERROR, error, false, NULL);
+		}
 	} else {
 		_show_not_status(TYPE_ERROR, error, __LINE__);
 	}
@@ -137,12 +163,8 @@ void reset_internal_error(SOUL_STATUS error)
 
 SOUL_STATUS get_first_error()
 {
-	for (unsigned i = ERRORS_START + 1; i < ERRORS_END; i++) {
-		if (_is_status((SOUL_STATUS)(i))) {
-			return i;
-		}
-	}
-	return NO_ERROR;
+	SOUL_STATUS error = _first_in_range(ERRORS_START + 1, ERRORS_END);
+	return error == SOUL_STATUSES_END ? NO_ERROR : error;
 }
 
 bool is_mcu_internal_error()
@@ -164,12 +186,12 @@ bool is_internal_status(SOUL_STATUS status)
 void set_internal_status(SOUL_STATUS status)
 {
 	if (status > STATUSES_START && status < STATUSES_END) {
+		if (_set_status(status)) {
 #if defined(__G_SOUL_BEDUG)
-		if (!_is_status(status)) {
 			soul.has_new_status_data = true;
-		}
 #endif
-		_set_status(status);
+			system_event_publish(GSYS_EVENT_STATUS, status, true, NULL);
+		}
 	} else {
 		_show_not_status(TYPE_STATUS, status, __LINE__);
 	}
@@ -178,12 +200,12 @@ void set_internal_status(SOUL_STATUS status)
 void reset_internal_status(SOUL_STATUS status)
 {
 	if (status > STATUSES_START && status < STATUSES_END) {
+		if (_reset_status(status)) {
 #if defined(__G_SOUL_BEDUG)
-		if (_is_status(status)) {
 			soul.has_new_status_data = true;
-		}
 #endif
-		_reset_status(status);
+			system_event_publish(GSYS_EVENT_STATUS, status, false, NULL);
+		}
 	} else {
 		_show_not_status(TYPE_STATUS, status, __LINE__);
 	}
@@ -193,20 +215,50 @@ bool _is_status(SOUL_STATUS status)
 {
 	return (bool)(
 		(
-			soul.statuses[status / BITS_IN_BYTE] >>
-			(status % BITS_IN_BYTE)
+			soul.statuses[status / SOUL_WORD_BITS] >>
+			(status % SOUL_WORD_BITS)
 		) & 0x01
 	);
 }
 
-void _set_status(SOUL_STATUS status)
+bool _set_status(SOUL_STATUS status)
+{
+	uint32_t bit = 1u << (status % SOUL_WORD_BITS);
+	if (soul.statuses[status / SOUL_WORD_BITS] & bit) {
+		return false;
+	}
+	if (g_atomic_fetch_or(&soul.statuses[status / SOUL_WORD_BITS], bit) & bit) {
+		return false;
+	}
+	g_atomic_fetch_add(&soul_generation, 1);
+	sys_soul_log_append(status, true);
+	return true;
+}
+
+bool _reset_status(SOUL_STATUS status)
 {
-	soul.statuses[status / BITS_IN_BYTE] |= (0x01 << (status % BITS_IN_BYTE));
+	uint32_t bit = 1u << (status % SOUL_WORD_BITS);
+	if (!(soul.statuses[status / SOUL_WORD_BITS] & bit)) {
+		return false;
+	}
+	if (!(g_atomic_fetch_and(&soul.statuses[status / SOUL_WORD_BITS], ~bit) & bit)) {
+		return false;
+	}
+	g_atomic_fetch_add(&soul_generation, 1);
+	sys_soul_log_append(status, false);
+	return true;
 }
 
-void _reset_status(SOUL_STATUS status)
+/* @brief Lowest set status in [lo, hi) with a CTZ per word, SOUL_STATUSES_END if none */
+static SOUL_STATUS _first_in_range(unsigned lo, unsigned hi)
 {
-	soul.statuses[status / BITS_IN_BYTE] &= (uint8_t)~(0x01 << (status % BITS_IN_BYTE));
+	for (unsigned w = lo / SOUL_WORD_BITS; w <= (hi - 1) / SOUL_WORD_BITS; w++) {
+		uint32_t bits = soul.statuses[w] & SOUL_RANGE_MASK(w, lo, hi);
+		if (bits) {
+			return (SOUL_STATUS)(w * SOUL_WORD_BITS + (unsigned)__builtin_ctz(bits));
+		}
+	}
+	return SOUL_STATUSES_END;
 }
 
 void _show_not_status(type_t type, SOUL_STATUS status, unsigned line)
@@ -224,133 +276,102 @@ void _show_not_status(type_t type, SOUL_STATUS status, unsigned line)
 		BEDUG_ASSERT(false, "Unknown type of soul statuses");
 		return;
 	}
-	SYSTEM_BEDUG("Soul status error: %s status is not %s. Line %u.", get_status_name(status), type_name, line);
+	SYSTEM_BEDUG("Soul status error: " SOUL_STATUS_FMT " status is not %s. Line %u.", SOUL_STATUS_ARG(status), type_name, line);
 }
 
-#define CASE_STATUS(SOUL_STATUS) case SOUL_STATUS:                   \
-									 ptr = __STR_DEF__(SOUL_STATUS); \
-									 break;
-char* get_status_name(SOUL_STATUS status)
-{
-	static char name[35] = { 0 };
-	memset(name, 0, sizeof(name));
 #if defined(__G_SOUL_BEDUG)
-	char* ptr = NULL;
-	switch (status) {
-	CASE_STATUS(SYSTEM_ERROR_HANDLER_CALLED)
-	CASE_STATUS(SYSTEM_HARDWARE_STARTED)
-	CASE_STATUS(SYSTEM_HARDWARE_READY)
-	CASE_STATUS(SYSTEM_SOFTWARE_STARTED)
-	CASE_STATUS(SYSTEM_SOFTWARE_READY)
-	CASE_STATUS(SYSTEM_SAFETY_MODE)
-	CASE_STATUS(SYS_TICK_FAULT)
-	CASE_STATUS(MEMORY_INITIALIZED)
-	CASE_STATUS(MEMORY_READ_FAULT)
-	CASE_STATUS(MEMORY_WRITE_FAULT)
-	CASE_STATUS(NEED_MEASURE)
-	CASE_STATUS(NEED_STANDBY)
-	CASE_STATUS(SETTINGS_INITIALIZED)
-	CASE_STATUS(SETTINGS_STOPPED)
-	CASE_STATUS(NEED_LOAD_SETTINGS)
-	CASE_STATUS(NEED_SAVE_SETTINGS)
-	CASE_STATUS(GSYS_ADC_READY)
-	CASE_STATUS(MODBUS_FAULT)
-	CASE_STATUS(PUMP_FAULT)
-	CASE_STATUS(RTC_FAULT)
-	CASE_STATUS(CAN_FAULT)
-	CASE_STATUS(PLL_FAULT)
-	CASE_STATUS(RTC_READY)
-	CASE_STATUS(MCU_ERROR)
-	CASE_STATUS(SYS_TICK_ERROR)
-	CASE_STATUS(RTC_ERROR)
-	CASE_STATUS(POWER_ERROR)
-	CASE_STATUS(EXPECTED_MEMORY_ERROR)
-	CASE_STATUS(MEMORY_ERROR)
-	CASE_STATUS(STACK_ERROR)
-	CASE_STATUS(RAM_ERROR)
-	CASE_STATUS(SD_CARD_ERROR)
-	CASE_STATUS(USB_ERROR)
-	CASE_STATUS(SETTINGS_LOAD_ERROR)
-	CASE_STATUS(APP_MODE_ERROR)
-	CASE_STATUS(PUMP_ERROR)
-	CASE_STATUS(VALVE_ERROR)
-	CASE_STATUS(FATFS_ERROR)
-	CASE_STATUS(LOAD_ERROR)
-	CASE_STATUS(I2C_ERROR)
-	CASE_STATUS(NON_MASKABLE_INTERRUPT)
-	CASE_STATUS(HARD_FAULT)
-	CASE_STATUS(MEM_MANAGE)
-	CASE_STATUS(BUS_FAULT)
-	CASE_STATUS(USAGE_FAULT)
-	CASE_STATUS(ASSERT_ERROR)
-	CASE_STATUS(ERROR_HANDLER_CALLED)
-	CASE_STATUS(INTERNAL_ERROR)
-	case STATUSES_START:
-	case STATUSES_END:
-	case NO_ERROR:
-	case ERRORS_START:
-	case ERRORS_END:
-	case SOUL_STATUSES_END:
-		snprintf(name, sizeof(name) - 1, "EMPTY STATUS");
-		break;
-	case RESERVED_STATUS_01:
-	case RESERVED_STATUS_02:
-	case RESERVED_STATUS_03:
-	case RESERVED_STATUS_04:
-	case RESERVED_STATUS_05:
-	case RESERVED_STATUS_06:
-	case RESERVED_STATUS_07:
-	case RESERVED_STATUS_08:
-	case RESERVED_STATUS_09:
-	case RESERVED_STATUS_10:
-	case RESERVED_STATUS_11:
-	case RESERVED_STATUS_12:
-	case RESERVED_STATUS_13:
-	case RESERVED_STATUS_14:
-	case RESERVED_STATUS_15:
-	case RESERVED_ERROR_01:
-	case RESERVED_ERROR_02:
-	case RESERVED_ERROR_03:
-	case RESERVED_ERROR_04:
-	case RESERVED_ERROR_05:
-	case RESERVED_ERROR_06:
-	case RESERVED_ERROR_07:
-	case RESERVED_ERROR_08:
-	case RESERVED_ERROR_09:
-	case RESERVED_ERROR_10:
-	case RESERVED_ERROR_11:
-	case RESERVED_ERROR_12:
-	case RESERVED_ERROR_13:
-	case RESERVED_ERROR_14:
-	case RESERVED_ERROR_15:
-	default:
-		ptr = get_custom_status_name(status);
-		break;
-	}
-	if (ptr) {
-		snprintf(
-			name,
-			sizeof(name) - 1,
-			"[%03u] %s",
-			(unsigned)status,
-			ptr
-		);
-	} else {
-		snprintf(name, sizeof(name) - 1, "[%03u]", status);
-	}
-	return name;
-#else
-	snprintf(name, sizeof(name) - 1, "[%03u]", status);
-	return name;
+/* @brief Built-in statuses with a printable name, in any order */
+#define SOUL_STATUS_NAMES(X)            \
+	X(SYSTEM_ERROR_HANDLER_CALLED)      \
+	X(SYSTEM_HARDWARE_STARTED)          \
+	X(SYSTEM_HARDWARE_READY)            \
+	X(SYSTEM_SOFTWARE_STARTED)          \
+	X(SYSTEM_SOFTWARE_READY)            \
+	X(SYSTEM_SAFETY_MODE)               \
+	X(SYS_TICK_FAULT)                   \
+	X(RTC_READY)                        \
+	X(MEMORY_INITIALIZED)               \
+	X(MEMORY_READ_FAULT)                \
+	X(MEMORY_WRITE_FAULT)               \
+	X(NEED_MEASURE)                     \
+	X(NEED_STANDBY)                     \
+	X(SETTINGS_INITIALIZED)             \
+	X(SETTINGS_STOPPED)                 \
+	X(NEED_LOAD_SETTINGS)               \
+	X(NEED_SAVE_SETTINGS)               \
+	X(GSYS_ADC_READY)                   \
+	X(MODBUS_FAULT)                     \
+	X(PUMP_FAULT)                       \
+	X(RTC_FAULT)                        \
+	X(CAN_FAULT)                        \
+	X(PLL_FAULT)                        \
+	X(MCU_ERROR)                        \
+	X(SYS_TICK_ERROR)                   \
+	X(RTC_ERROR)                        \
+	X(POWER_ERROR)                      \
+	X(EXPECTED_MEMORY_ERROR)            \
+	X(MEMORY_ERROR)                     \
+	X(STACK_ERROR)                      \
+	X(RAM_ERROR)                        \
+	X(SD_CARD_ERROR)                    \
+	X(USB_ERROR)                        \
+	X(SETTINGS_LOAD_ERROR)              \
+	X(APP_MODE_ERROR)                   \
+	X(PUMP_ERROR)                       \
+	X(VALVE_ERROR)                      \
+	X(FATFS_ERROR)                      \
+	X(LOAD_ERROR)                       \
+	X(I2C_ERROR)                        \
+	X(NON_MASKABLE_INTERRUPT)           \
+	X(HARD_FAULT)                       \
+	X(MEM_MANAGE)                       \
+	X(BUS_FAULT)                        \
+	X(USAGE_FAULT)                      \
+	X(ASSERT_ERROR)                     \
+	X(ERROR_HANDLER_CALLED)             \
+	X(INTERNAL_ERROR)
+
+/* @brief Section markers, printed as "EMPTY STATUS" */
+#define SOUL_STATUS_MARKERS(X)          \
+	X(STATUSES_START)                   \
+	X(STATUSES_END)                     \
+	X(NO_ERROR)                         \
+	X(ERRORS_START)                     \
+	X(ERRORS_END)                       \
+	X(SOUL_STATUSES_END)
+
+#define SOUL_STATUS_NAME(STATUS)   [STATUS] = __STR_DEF__(STATUS),
+#define SOUL_STATUS_MARKER(STATUS) [STATUS] = "EMPTY STATUS",
+
+/*
+ * @brief Status names indexed by SOUL_STATUS, built by the preprocessor and
+ *        kept in flash. Unnamed reserved statuses are NULL.
+ */
+static const char* const soul_status_names[SOUL_STATUSES_END + 1] = {
+	SOUL_STATUS_MARKERS(SOUL_STATUS_MARKER)
+	SOUL_STATUS_NAMES(SOUL_STATUS_NAME)
+#if defined(GSYSTEM_CUSTOM_STATUS_NAMES)
+	GSYSTEM_CUSTOM_STATUS_NAMES(SOUL_STATUS_NAME)
 #endif
-}
+};
 
-__attribute__((weak)) char* get_custom_status_name(SOUL_STATUS status)
+#undef SOUL_STATUS_NAME
+#undef SOUL_STATUS_MARKER
+#undef SOUL_STATUS_NAMES
+#undef SOUL_STATUS_MARKERS
+#endif
+
+const char* get_status_name(SOUL_STATUS status)
 {
+#if defined(__G_SOUL_BEDUG)
+	if ((unsigned)status <= SOUL_STATUSES_END && soul_status_names[status]) {
+		return soul_status_names[status];
+	}
+#else
 	(void)status;
-	return (char*)SOUL_UNKNOWN_STATUS;
+#endif
+	return SOUL_UNKNOWN_STATUS;
 }
-#undef CASE_STATUS
 
 #if defined(__G_SOUL_BEDUG)
 
@@ -375,7 +396,7 @@ void show_statuses()
 			continue;
 		}
 		cnt++;
-		printPretty("%s\n", get_status_name(i));
+		printPretty(SOUL_STATUS_FMT "\n", SOUL_STATUS_ARG(i));
 	}
 	if (!cnt) {
 		printPretty("NO_STATUSES\n");
@@ -393,7 +414,7 @@ void show_errors()
 			continue;
 		}
 		cnt++;
-		printPretty("%s\n", get_status_name(i));
+		printPretty(SOUL_STATUS_FMT "\n", SOUL_STATUS_ARG(i));
 	}
 	if (!cnt) {
 		printPretty("%s\n", __STR_DEF__(NO_ERROR));
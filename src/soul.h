@@ -95,7 +95,6 @@ extern "C" {
 // timestamp (if clocks available else 0); internal time ms; fw build time; gsystem version; soul version; device version; all statuses at the moment of reboot in array of strings; 
 // also need to add the error log file size limit.
 // also add to error logs full memory rewrite or the first settings write.
-// rename error logs to soul logs
 #define SOUL_STATUS_VERSION 1
 
 
@@ -264,6 +263,14 @@ void reset_internal_error(SOUL_STATUS error);
  */
 SOUL_STATUS get_first_error();
 
+/*
+ * @brief Get the soul generation counter. It changes on every status or
+ *        error change, so cached checks may be recomputed only on a change.
+ * @param None
+ * @return uint32_t - Current generation.
+ */
+uint32_t get_soul_generation();
+
 /*
  * @brief Check if the device has recorded an MCU internal error.
  * @param None
@@ -293,46 +300,33 @@ void set_internal_status(SOUL_STATUS status);
 void reset_internal_status(SOUL_STATUS status);
 
 
-#define CASE_CUSTOM_STATUS(SOUL_STATUS) case SOUL_STATUS:                \
-											snprintf(                    \
-												name,                    \
-												sizeof(name) - 1,        \
-												"%s",                    \
-												__STR_DEF__(SOUL_STATUS) \
-											);                           \
-										break;
-
-
 /*
- * @brief Convert a `SOUL_STATUS` into a human-readable name.
- * @param status (SOUL_STATUS) - Status to convert.
- * @return char* - Pointer to a static string with the status name.
+ * @def SOUL_STATUS_FMT
+ * @brief printf format of a status: the code and the name ("[042] HARD_FAULT").
+ *        Used together with `SOUL_STATUS_ARG(STATUS)`.
+ *
+ * @def SOUL_STATUS_ARG(STATUS)
+ * @brief printf arguments for `SOUL_STATUS_FMT`.
+ * @param STATUS (SOUL_STATUS) - Status to print.
  */
-char* get_status_name(SOUL_STATUS status);
+#define SOUL_STATUS_FMT         "[%03u] %s"
+#define SOUL_STATUS_ARG(STATUS) (unsigned)(STATUS), get_status_name((SOUL_STATUS)(STATUS))
+
 
 /*
  * @brief Convert a `SOUL_STATUS` into a human-readable name.
- * @note A weak default implementation of `get_custom_status_name()` is
- *       provided by the library which returns a generic string. To supply
- *       application-specific human-readable names for custom statuses, implement
- *       a non-weak `get_custom_status_name(SOUL_STATUS)` in your project; the
- *       linker will prefer the user definition over the weak default.
- * @param status (SOUL_STATUS) - Custom status to convert.
- * @return char* - Pointer to a static string with the custom status name.
- * @example char* get_custom_status_name(SOUL_STATUS status) {
- *              static char name[35] = { 0 };
- *              memset(name, 0, sizeof(name))
- *              switch (status) {
- * 				case MY_CUSTOM_STATUS:
- *                  SYSTEM_CASE_STATUS(name, CUSTOM_STATUS_01)
- *              default:
- *                  snprintf(name, sizeof(name) - 1, "%s", SOUL_UNKNOWN_STATUS);
- *                  break;
- *              }
- *              return name;
- *  	    }
+ * @note Names are looked up in a constant table generated at compile time, the
+ *       function is reentrant and may be called from interrupt handlers.
+ *       Names of custom statuses are registered with
+ *       `GSYSTEM_CUSTOM_STATUS_NAMES(X)` in gconfig.h. The section markers
+ *       (STATUSES_START, ERRORS_END etc.) return "EMPTY STATUS". Unnamed and
+ *       out of range statuses and builds without the status print (see
+ *       `GSYSTEM_NO_STATUS_PRINT`) return `SOUL_UNKNOWN_STATUS`.
+ * @param status (SOUL_STATUS) - Status to convert.
+ * @return const char* - Pointer to the constant status name, never NULL.
+ * @example printTagLog(TAG, "error " SOUL_STATUS_FMT, SOUL_STATUS_ARG(MEMORY_ERROR));
  */
-char* get_custom_status_name(SOUL_STATUS status);
+const char* get_status_name(SOUL_STATUS status);
 
 /*
  * @brief Check whether there is new error data that hasn't been processed.
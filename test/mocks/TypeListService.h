@@ -0,0 +1,4 @@
+#ifndef _TYPE_LIST_SERVICE_H_
+#define _TYPE_LIST_SERVICE_H_
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * @file bmacro.h
+ * @brief Host replacement of the Utils library macros used by gsystem.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _BMACRO_H_
+#define _BMACRO_H_
+
+
+#include "glog.h"
+
+
+#define BEDUG_ASSERT(COND, MSG)          if (!(COND)) { printTagLog("ASSERT", "%s", (MSG)); }
+
+#define __arr_len(ARR)                   (sizeof(ARR) / sizeof(*(ARR)))
+#define __div_up(A, B)                   (((A) + (B) - 1) / (B))
+#define __abs(A)                         ((A) < 0 ? -(A) : (A))
+#define __min(A, B)                      ((A) < (B) ? (A) : (B))
+#define __max(A, B)                      ((A) > (B) ? (A) : (B))
+#define __proportion(X, IN_MIN, IN_MAX, OUT_MIN, OUT_MAX) \
+    (((X) - (IN_MIN)) * ((OUT_MAX) - (OUT_MIN)) / ((IN_MAX) - (IN_MIN)) + (OUT_MIN))
+#define __STR_DEF__(X)                   #X
+#define __CONCAT_IMPL(A, B)              A##B
+#define __concat(A, B)                   __CONCAT_IMPL(A, B)
+#define __set_bit(REG, BIT)              ((REG) |= (BIT))
+#define __reset_bit(REG, BIT)            ((REG) &= ~(BIT))
+#define __rm_mod(A, B)                   ((A) - ((A) % (B)))
+
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * @file gconfig.h
+ * @brief gsystem configuration of the host unit tests.
+ *
+ * The hardware watchdogs are disabled, the scheduler with the latency
+ * histograms, the post queue, the events, the timing wheel, the trace,
+ * the soul log, the tickless idle, the ISR tier, the EDF tier, the
+ * high-resolution timers and the crash record check (without the
+ * capture) are built for the host.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _G_SYSTEM_CONFIG_H_
+#define _G_SYSTEM_CONFIG_H_
+
+
+#include "soul.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define GSYSTEM_POCESSES_COUNT      (64)
+
+#define GSYSTEM_NO_RESTART_W
+#define GSYSTEM_NO_RTC_W
+#define GSYSTEM_NO_SYS_TICK_W
+#define GSYSTEM_NO_RAM_W
+#define GSYSTEM_NO_ADC_W
+#define GSYSTEM_NO_I2C_W
+#define GSYSTEM_NO_POWER_W
+#define GSYSTEM_NO_MEMORY_W
+#define GSYSTEM_NO_PLL_CHECK_W
+#define GSYSTEM_NO_STORAGE_AT
+#define GSYSTEM_NO_REVISION
+#define GSYSTEM_NO_DEVICE_SETTINGS
+
+#define GSYSTEM_NO_PRINTF
+#define GSYSTEM_NO_CPU_INFO
+#define GSYSTEM_NO_BEDUG
+// The status names without the debug output
+#define GBEDUG_FORCE
+
+#define GSYSTEM_SCHEDULER_EDF
+#define GSYSTEM_PROC_HISTOGRAM
+#define GSYSTEM_CRASH_DUMP
+#define GSYSTEM_TIMER_WHEEL
+#define GSYSTEM_SOUL_LOG
+#define GSYSTEM_TRACE
+#define GSYSTEM_TRACE_SIZE          (16)
+
+#define GSYSTEM_TIMER               (TIM1)
+#define GSYSTEM_TICKLESS_IDLE
+#define GSYSTEM_ISR_TIMER           (TIM2)
+#define GSYSTEM_HRT_TIMER           (TIM3)
+
+#define GSYSTEM_BUTTONS_COUNT       (0)
+
+typedef enum _HOST_SOUL_STATUSES {
+	HOST_CUSTOM_STATUS = RESERVED_STATUS_14
+} HOST_SOUL_STATUSES;
+#define GSYSTEM_CUSTOM_STATUS_NAMES(X) \
+	X(HOST_CUSTOM_STATUS)
+
+#define GSYSTEM_EVENT_SUBSCRIBERS(X) \
+    X(GSYS_EVENT_RESET, host_event_handler) \
+    X(GSYS_EVENT_USER,  host_event_handler)
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * @file glog.h
+ * @brief Host replacement of the Utils library log output.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _GLOG_H_
+#define _GLOG_H_
+
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+void gprint(const char* format, ...);
+void printTagLog(const char* tag, const char* format, ...);
+void printPretty(const char* format, ...);
+void printMessage(const char* format, va_list args);
+void util_debug_hex_dump(const uint8_t* data, uint32_t addr, uint16_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
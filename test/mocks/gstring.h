@@ -0,0 +1,6 @@
+#ifndef _GSTRING_H_
+#define _GSTRING_H_
+
+#include <string.h>
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * @file gtimer.h
+ * @brief Host replacement of the Utils library timers on the system time.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _GTIMER_H_
+#define _GTIMER_H_
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef uint64_t g_time_t;
+
+typedef struct _gtimer_t {
+    g_time_t start;
+    g_time_t delay;
+} gtimer_t;
+
+void gtimer_start(gtimer_t* tm, g_time_t delay);
+bool gtimer_wait(const gtimer_t* tm);
+void gtimer_reset(gtimer_t* tm);
+
+g_time_t getMillis(void);
+uint64_t getMicroseconds(void);
+
+
+#ifdef __cplusplus
+}
+
+
+namespace utl {
+
+class GTimer {
+private:
+    uint32_t start_ms;
+    uint32_t delay_ms;
+
+public:
+    GTimer(uint32_t delay_ms = 0): start_ms((uint32_t)getMillis()), delay_ms(delay_ms) {}
+
+    void start()
+    {
+        start_ms = (uint32_t)getMillis();
+    }
+
+    bool wait()
+    {
+        return (uint32_t)getMillis() - start_ms < delay_ms;
+    }
+
+    uint32_t end()
+    {
+        return start_ms + delay_ms;
+    }
+
+    uint32_t getStart()
+    {
+        return start_ms;
+    }
+
+    uint32_t getDelay()
+    {
+        return delay_ms;
+    }
+
+    void changeDelay(uint32_t delay)
+    {
+        delay_ms = delay;
+    }
+
+    void reset()
+    {
+        start_ms = (uint32_t)getMillis() - delay_ms;
+    }
+};
+
+}
+
+#endif
+
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * @file gutils.h
+ * @brief Host replacement of the Utils library helpers used by gsystem.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _GUTILS_H_
+#define _GUTILS_H_
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "glog.h"
+#include "gtimer.h"
+#include "bmacro.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+bool util_wait_event(bool (*condition)(void), uint32_t time_ms);
+
+uint32_t util_hash(const uint8_t* data, unsigned len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
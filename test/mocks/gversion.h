@@ -0,0 +1,4 @@
+#ifndef _GVERSION_H_
+#define _GVERSION_H_
+
+#endif
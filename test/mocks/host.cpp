@@ -0,0 +1,334 @@
+/*
+ * @file host.cpp
+ * @brief Host implementation of the platform functions gsystem sources
+ *        under test call: the system time, the log output and the stubs
+ *        of the disabled parts.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include "gdefines.h"
+#include "gconfig.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+#include "host.h"
+#include "glog.h"
+#include "gsystem.h"
+#include "drivers.h"
+
+
+volatile uint64_t host_time_us             = 0;
+uint32_t          host_primask             = 0;
+uint32_t          host_ipsr                = 0;
+uint32_t          host_error_handler_calls = 0;
+uint32_t          host_clock_step_us       = 0;
+uint32_t          host_sleep_calls         = 0;
+uint32_t          host_sleep_request_ms    = 0;
+uint32_t          host_sleep_wake_ms       = 0;
+void              (*host_sleep_irq)(void)  = nullptr;
+uint32_t          host_isr_timer_delay_us    = 0;
+uint64_t          host_isr_timer_deadline_us = 0;
+uint32_t          host_before_reset_calls    = 0;
+uint32_t          host_reboot_calls          = 0;
+void              (*host_event_hook)(const gsys_event_t*) = nullptr;
+
+bool              host_hrt_compare_enabled   = false;
+uint16_t          host_hrt_compare           = 0;
+uint32_t          host_hrt_forced_compares   = 0;
+
+static void (*host_isr_timer_callback)(void) = nullptr;
+static void (*host_hrt_timer_callback)(void) = nullptr;
+static uint64_t host_hrt_timer_start_us      = 0;
+static bool     host_hrt_irq_pending         = false;
+
+TIM_TypeDef host_tim1 = {};
+TIM_TypeDef host_tim2 = {};
+TIM_TypeDef host_tim3 = {};
+
+volatile uint32_t sys_time_ms      = 0;
+volatile uint32_t sys_time_ms_half = 0;
+
+
+extern "C" void host_advance_us(uint64_t us)
+{
+    uint64_t prev_ms = host_time_us / MILLIS_US;
+    host_time_us = host_time_us + us;
+
+    // The system tick: the millisecond counters follow the virtual time
+    uint64_t ms = host_time_us / MILLIS_US - prev_ms;
+    while (ms) {
+        uint32_t step = (uint32_t)(ms < 0x40000000 ? ms : 0x40000000);
+        g_sys_time_add(step);
+        ms -= step;
+    }
+}
+
+extern "C" void host_set_time_us(uint64_t us)
+{
+    uint64_t ms = us / MILLIS_US;
+    host_time_us     = us;
+    sys_time_ms      = (uint32_t)ms;
+    sys_time_ms_half = (uint32_t)(ms >> 31);
+}
+
+extern "C" bool g_sys_tick_sleep(uint32_t ms)
+{
+    host_sleep_calls++;
+    host_sleep_request_ms = ms;
+
+    // The stretched system tick compensates sys_time_ms by the slept time on wake up
+    bool woken = host_sleep_wake_ms && host_sleep_wake_ms < ms;
+    host_advance_us((uint64_t)(woken ? host_sleep_wake_ms : ms) * MILLIS_US);
+    host_sleep_wake_ms = 0;
+    if (woken && host_sleep_irq) {
+        host_sleep_irq();
+    }
+    return true;
+}
+
+extern "C" bool g_hw_timer_start_us(hard_tim_t* timer, void (*callback) (void), uint32_t delay_us, uint8_t prio)
+{
+    (void)prio;
+    if (timer != GSYSTEM_ISR_TIMER || !callback) {
+        return false;
+    }
+    host_isr_timer_callback = callback;
+    g_hw_timer_rearm_us(timer, delay_us);
+    return true;
+}
+
+extern "C" void g_hw_timer_rearm_us(hard_tim_t* timer, uint32_t delay_us)
+{
+    (void)timer;
+    host_isr_timer_delay_us    = delay_us;
+    host_isr_timer_deadline_us = host_time_us + delay_us;
+}
+
+extern "C" void host_isr_timer_fire()
+{
+    if (host_isr_timer_deadline_us > host_time_us) {
+        host_advance_us(host_isr_timer_deadline_us - host_time_us);
+    }
+    host_ipsr = 1;
+    host_isr_timer_callback();
+    host_ipsr = 0;
+}
+
+extern "C" bool g_hw_timer_start_free_us(hard_tim_t* timer, void (*callback) (void), uint8_t prio)
+{
+    (void)prio;
+    if (timer != GSYSTEM_HRT_TIMER || !callback) {
+        return false;
+    }
+    host_hrt_timer_callback  = callback;
+    host_hrt_timer_start_us  = host_time_us;
+    host_hrt_compare_enabled = false;
+    return true;
+}
+
+extern "C" uint16_t g_hw_timer_count(hard_tim_t* timer)
+{
+    (void)timer;
+    return (uint16_t)(host_time_us - host_hrt_timer_start_us);
+}
+
+extern "C" void g_hw_timer_set_compare(hard_tim_t* timer, uint16_t count)
+{
+    (void)timer;
+    host_hrt_compare_enabled = true;
+    host_hrt_compare         = count;
+}
+
+static void host_hrt_timer_irq()
+{
+    host_hrt_irq_pending = false;
+    host_ipsr = 1;
+    host_hrt_timer_callback();
+    host_ipsr = 0;
+}
+
+extern "C" void g_hw_timer_force_compare(hard_tim_t* timer)
+{
+    (void)timer;
+    host_hrt_forced_compares++;
+    host_hrt_irq_pending = true;
+    if (!host_primask) {
+        host_irq_unmasked();
+    }
+}
+
+extern "C" void host_irq_unmasked()
+{
+    // The thread mode only, the raised interrupt doesn't preempt the running handler
+    if (host_hrt_irq_pending && !host_ipsr) {
+        host_hrt_timer_irq();
+    }
+}
+
+extern "C" void g_hw_timer_stop_compare(hard_tim_t* timer)
+{
+    (void)timer;
+    host_hrt_compare_enabled = false;
+}
+
+extern "C" uint32_t g_hw_timers_unclaimed(void)
+{
+    return 0;
+}
+
+extern "C" void host_hrt_timer_advance_us(uint64_t us)
+{
+    host_irq_unmasked();
+    while (us) {
+        uint16_t cnt         = g_hw_timer_count(GSYSTEM_HRT_TIMER);
+        uint32_t overflow_us = 0x10000 - (uint32_t)cnt;
+        uint32_t compare_us  = (uint16_t)(host_hrt_compare - cnt);
+        if (!host_hrt_compare_enabled || !compare_us) {
+            compare_us = 0x10000;
+        }
+        uint64_t step_us = us;
+        step_us = step_us < overflow_us ? step_us : overflow_us;
+        step_us = step_us < compare_us ? step_us : compare_us;
+
+        host_advance_us(step_us);
+        us -= step_us;
+        if (step_us == overflow_us || step_us == compare_us) {
+            host_hrt_timer_irq();
+        }
+    }
+}
+
+extern "C" uint64_t system_micros()
+{
+    if (host_clock_step_us) {
+        host_advance_us(host_clock_step_us);
+    }
+    return host_time_us;
+}
+
+extern "C" uint64_t system_nanos()
+{
+    return host_time_us * 1000;
+}
+
+extern "C" uint64_t system_millis64()
+{
+    return g_sys_time_read_ms64();
+}
+
+extern "C" uint32_t system_millis()
+{
+    return sys_time_ms;
+}
+
+extern "C" void system_delay_us(uint64_t us)
+{
+    host_advance_us(us);
+}
+
+extern "C" g_time_t getMillis(void)
+{
+    return system_millis64();
+}
+
+extern "C" uint64_t getMicroseconds(void)
+{
+    return system_micros();
+}
+
+extern "C" void system_error_handler(SOUL_STATUS error)
+{
+    (void)error;
+    host_error_handler_calls++;
+    set_status(SYSTEM_ERROR_HANDLER_CALLED);
+}
+
+extern "C" bool is_system_ready(void)
+{
+    return !has_errors();
+}
+
+extern "C" bool is_software_ready(void)
+{
+    return true;
+}
+
+extern "C" const char* system_device_version()
+{
+    return BUILD_VERSION;
+}
+
+extern "C" char* get_system_serial_str(void)
+{
+    static char serial[] = "0";
+    return serial;
+}
+
+extern "C" void system_set_print_color(const char* color)
+{
+    (void)color;
+}
+
+extern "C" void system_print_clear() {}
+
+extern "C" void SYSTEM_BEDUG(const char* format, ...)
+{
+    (void)format;
+}
+
+extern "C" void g_uart_print(const char* data, const uint16_t len)
+{
+    (void)data;
+    (void)len;
+}
+
+extern "C" void btn_watchdog_check() {}
+
+extern "C" void host_event_handler(const gsys_event_t* event)
+{
+    if (host_event_hook) {
+        host_event_hook(event);
+    }
+}
+
+extern "C" void system_before_reset(void)
+{
+    host_before_reset_calls++;
+}
+
+extern "C" void g_reboot()
+{
+    host_reboot_calls++;
+}
+
+extern "C" uint32_t util_hash(const uint8_t* data, unsigned len)
+{
+    // FNV-1a
+    uint32_t hash = 0x811C9DC5;
+    for (unsigned i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+extern "C" void gprint(const char* format, ...)
+{
+    (void)format;
+}
+
+extern "C" void printTagLog(const char* tag, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s: ", tag);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+extern "C" void printPretty(const char* format, ...)
+{
+    (void)format;
+}
@@ -0,0 +1,97 @@
+/*
+ * @file host.h
+ * @brief Host doubles of the target state used by the unit tests.
+ *
+ * The system time is a variable moved by the tests (and by the jobs under
+ * test through system_delay_us()), the millisecond counters of the target
+ * (sys_time_ms, sys_time_ms_half) follow it like the system tick does, so
+ * the 32-bit millisecond time wraps as on the target. The interrupt state
+ * is emulated by the PRIMASK and IPSR variables of the HAL replacement.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _HOST_H_
+#define _HOST_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+extern volatile uint64_t host_time_us;
+extern uint32_t host_primask;
+extern uint32_t host_ipsr;
+
+/* @brief Running clock: every system_micros() call moves the time by the step, 0 - frozen time */
+extern uint32_t host_clock_step_us;
+
+/* @brief Move the system time forward */
+void host_advance_us(uint64_t us);
+
+/* @brief Set the system time and the millisecond counters at once */
+void host_set_time_us(uint64_t us);
+
+/*
+ * @brief Tickless sleep of the system timer (g_sys_tick_sleep()): the number of
+ *        sleeps and the last requested time. The virtual time moves by the slept
+ *        time; an interrupt set by host_sleep_wake_ms ends the sleep earlier and
+ *        host_sleep_irq is called as its handler.
+ */
+extern uint32_t host_sleep_calls;
+extern uint32_t host_sleep_request_ms;
+extern uint32_t host_sleep_wake_ms;
+extern void (*host_sleep_irq)(void);
+
+/*
+ * @brief The 1 us ISR timer (g_hw_timer_start_us()): the last armed delay and
+ *        its absolute deadline on the virtual clock.
+ */
+extern uint32_t host_isr_timer_delay_us;
+extern uint64_t host_isr_timer_deadline_us;
+
+/* @brief Move the system time to the ISR timer deadline and call its interrupt handler */
+void host_isr_timer_fire(void);
+
+/*
+ * @brief The free running 16-bit 1 us HRT timer (g_hw_timer_start_free_us()):
+ *        the counter follows the virtual time from the timer start, the channel 1
+ *        compare value and the number of the compare interrupts raised by software.
+ *        A software raised interrupt waits for the interrupts to be unmasked.
+ */
+extern bool     host_hrt_compare_enabled;
+extern uint16_t host_hrt_compare;
+extern uint32_t host_hrt_forced_compares;
+
+/* @brief Move the system time, the HRT interrupt handler is called on the overflows and the compare matches */
+void host_hrt_timer_advance_us(uint64_t us);
+
+/* @brief Take the interrupts raised by software while the interrupts were masked */
+void host_irq_unmasked(void);
+
+/*
+ * @brief Subscriber of the host event topics (GSYSTEM_EVENT_SUBSCRIBERS of the
+ *        host gconfig.h), every delivered event is passed to host_event_hook.
+ */
+struct _gsys_event_t;
+extern void (*host_event_hook)(const struct _gsys_event_t* event);
+
+/* @brief Number of system_before_reset() and g_reboot() calls */
+extern uint32_t host_before_reset_calls;
+extern uint32_t host_reboot_calls;
+
+/* @brief Number of system_error_handler() calls */
+extern uint32_t host_error_handler_calls;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
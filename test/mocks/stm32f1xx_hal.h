@@ -0,0 +1,108 @@
+/*
+ * @file stm32f1xx_hal.h
+ * @brief Host replacement of the STM32F1 HAL for the unit tests.
+ *
+ * Provides the register types, the system timer instance and the CMSIS
+ * core intrinsics used by gsystem. PRIMASK and IPSR are plain variables,
+ * so the tests can run code "in an interrupt" or with masked interrupts.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#ifndef _STM32F1XX_HAL_H_
+#define _STM32F1XX_HAL_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <stdint.h>
+
+#include "host.h"
+
+
+#define STM32F1
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+    volatile uint32_t RCR;
+    volatile uint32_t CCR1;
+} TIM_TypeDef;
+
+typedef struct {
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+extern TIM_TypeDef host_tim1;
+extern TIM_TypeDef host_tim2;
+extern TIM_TypeDef host_tim3;
+
+#define TIM1             (&host_tim1)
+#define TIM2             (&host_tim2)
+#define TIM3             (&host_tim3)
+
+#define TIM_SR_UIF       ((uint32_t)0x0001)
+#define TIM_SR_CC1IF     ((uint32_t)0x0002)
+
+
+static inline uint32_t __get_PRIMASK(void)
+{
+    return host_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    host_primask = primask;
+    if (!primask) {
+        host_irq_unmasked();
+    }
+}
+
+static inline void __disable_irq(void)
+{
+    host_primask = 1;
+}
+
+static inline void __enable_irq(void)
+{
+    host_primask = 0;
+    host_irq_unmasked();
+}
+
+static inline uint32_t __get_IPSR(void)
+{
+    return host_ipsr;
+}
+
+static inline void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB(void) {}
+static inline void __WFI(void) {}
+static inline void __NOP(void) {}
+
+static inline uint32_t ITM_SendChar(uint32_t ch)
+{
+    return ch;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -79,6 +79,10 @@ typedef enum _CUSTOM_SOUL_STATUSES {
 	CUSTOM_STATUS_02 = RESERVED_STATUS_02
 } CUSTOM_SOUL_STATUSES;
 
+#define GSYSTEM_CUSTOM_STATUS_NAMES(X) \
+	X(CUSTOM_STATUS_01)               \
+	X(CUSTOM_STATUS_02)
+
 
 // enum DEVICE_TYPE {
 // 	DT_DEVICE_1 = 0x0001,
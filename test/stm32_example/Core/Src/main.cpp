@@ -211,20 +211,6 @@ void system_error_loop()
     }
 }
 
-char* get_custom_status_name(SOUL_STATUS status)
-{
-    static char name[35] = { 0 };
-    memset(name, 0, sizeof(name));
-
-    switch (status) {
-    SYSTEM_CASE_STATUS(name, CUSTOM_STATUS_01)
-    default:
-        snprintf(name, sizeof(name) - 1, "%s", SOUL_UNKNOWN_STATUS);
-        break;
-    }
-
-    return name;
-}
 /* USER CODE END 4 */
 
 /**
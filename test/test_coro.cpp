@@ -0,0 +1,163 @@
+/*
+ * @file test_coro.cpp
+ * @brief Coroutine job tests (gcoroutine.h): the resume points across the
+ *        scheduler launches, the delays and the awaits with a timeout.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gsystem.h"
+#include "gcoroutine.h"
+#include "host.h"
+
+
+extern "C" void sys_jobs_init();
+
+
+static constexpr uint32_t DELAY_MS   = 10;
+static constexpr uint32_t TIMEOUT_MS = 20;
+
+struct Step {
+    unsigned point;
+    uint32_t at_ms;
+};
+
+static gsys_coro_t       coro      = {};
+static std::vector<Step> steps;
+static uint32_t          launches  = 0;
+static bool              ready     = false;
+static bool              timed_out = false;
+
+static void step(unsigned point)
+{
+    steps.push_back({point, system_millis()});
+}
+
+static void coro_job()
+{
+    launches++;
+
+    GSYS_CORO_BEGIN(&coro);
+    step(1);
+    GSYS_CORO_YIELD(&coro);
+    step(2);
+    GSYS_CORO_DELAY(&coro, DELAY_MS);
+    step(3);
+    GSYS_CORO_AWAIT_TIMEOUT(&coro, ready, TIMEOUT_MS);
+    timed_out = !ready;
+    step(4);
+    GSYS_CORO_AWAIT_STATUS(&coro, RESERVED_STATUS_05);
+    step(5);
+    GSYS_CORO_END(&coro);
+}
+
+
+class CoroTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        host_set_time_us(0);
+        sys_jobs_init();
+    }
+
+    void SetUp() override
+    {
+        coro      = {};
+        launches  = 0;
+        ready     = false;
+        timed_out = false;
+        steps.clear();
+        job = system_register(coro_job, 1, true, true, 100);
+        ASSERT_NE(job, GSYS_JOB_INVALID);
+    }
+
+    void TearDown() override
+    {
+        EXPECT_TRUE(system_job_remove(job));
+        reset_status(RESERVED_STATUS_05);
+    }
+
+    static void run_ms(uint32_t ms)
+    {
+        for (uint32_t i = 0; i < ms; i++) {
+            host_advance_us(MILLIS_US);
+            system_tick();
+        }
+    }
+
+    /* @brief Tick until the coroutine passes the point */
+    static const Step& run_until(unsigned point, uint32_t max_ms = SECOND_MS)
+    {
+        for (uint32_t i = 0; i < max_ms && (steps.empty() || steps.back().point < point); i++) {
+            run_ms(1);
+        }
+        EXPECT_FALSE(steps.empty());
+        EXPECT_EQ(steps.back().point, point);
+        return steps.back();
+    }
+
+    gsys_job_t job = GSYS_JOB_INVALID;
+};
+
+
+TEST_F(CoroTest, ResumesAfterTheAwaitPoints)
+{
+    // One point per launch: the yield returns to the scheduler
+    run_until(1);
+    uint32_t first = launches;
+    run_until(2);
+    EXPECT_EQ(launches, first + 1);
+    uint32_t delay_start_ms = steps.back().at_ms;
+
+    // The delay keeps the job waiting for DELAY_MS, every launch resumes at the await
+    uint32_t delay_end_ms = run_until(3).at_ms;
+    EXPECT_EQ(delay_end_ms - delay_start_ms, DELAY_MS);
+    EXPECT_GE(launches - first, DELAY_MS);
+
+    // The condition comes before the timeout
+    run_ms(TIMEOUT_MS / 2);
+    ASSERT_EQ(steps.back().point, 3U);
+    ready = true;
+    uint32_t ready_ms = system_millis();
+    EXPECT_LE(run_until(4).at_ms - ready_ms, 1U);
+    EXPECT_FALSE(timed_out);
+
+    // The status await, then the next launch starts from the beginning
+    run_ms(5);
+    ASSERT_EQ(steps.back().point, 4U);
+    set_status(RESERVED_STATUS_05);
+    run_until(5);
+    EXPECT_FALSE(GSYS_CORO_RUNNING(&coro));
+    run_ms(1);
+    ASSERT_EQ(steps.size(), 6U);
+    EXPECT_EQ(steps.back().point, 1U);
+}
+
+TEST_F(CoroTest, AwaitWithTimeoutEndsOnTime)
+{
+    uint32_t wait_start_ms = run_until(3).at_ms;
+
+    // No condition: the await ends after TIMEOUT_MS
+    uint32_t wait_end_ms = run_until(4).at_ms;
+    EXPECT_TRUE(timed_out);
+    EXPECT_EQ(wait_end_ms - wait_start_ms, TIMEOUT_MS);
+    EXPECT_TRUE(GSYS_CORO_RUNNING(&coro));
+}
+
+TEST_F(CoroTest, TimeoutAcrossTheMillisecondWrap)
+{
+    // The await starts 10 ms before the 32-bit millisecond counter wrap
+    run_until(2);
+    host_set_time_us(((uint64_t)UINT32_MAX + 1 - 10) * MILLIS_US);
+    uint32_t wait_start_ms = run_until(3).at_ms;
+    ASSERT_GT(wait_start_ms, UINT32_MAX - TIMEOUT_MS);
+
+    uint32_t wait_end_ms = run_until(4).at_ms;
+    EXPECT_LT(wait_end_ms, TIMEOUT_MS);
+    EXPECT_TRUE(timed_out);
+    EXPECT_EQ((uint32_t)(wait_end_ms - wait_start_ms), TIMEOUT_MS);
+}
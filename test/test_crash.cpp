@@ -0,0 +1,118 @@
+/*
+ * @file test_crash.cpp
+ * @brief Crash record tests (GSYSTEM_CRASH_DUMP): the magic and hash check
+ *        of the record kept over the reset and the single flush. The fault
+ *        capture itself is target only.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" gsys_crash_dump_t* sys_crash_dump_begin();
+extern "C" void sys_crash_dump_seal();
+extern "C" bool sys_crash_dump_pending();
+extern "C" void crash_dump_flush();
+
+
+/* @brief Write a record like sys_crash_capture() does */
+static gsys_crash_dump_t* capture(uint32_t pc)
+{
+    gsys_crash_dump_t* dump = sys_crash_dump_begin();
+    dump->fault       = HARD_FAULT;
+    dump->pc          = pc;
+    dump->lr          = 0x08000201;
+    dump->job_id      = 3;
+    dump->stack_words = 2;
+    dump->stack[0]    = 0xDEADBEEF;
+    dump->stack[1]    = 0x20000100;
+    sys_crash_dump_seal();
+    return dump;
+}
+
+
+class CrashTest : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        system_crash_dump_clear();
+    }
+};
+
+
+TEST_F(CrashTest, SealedRecordIsRecovered)
+{
+    capture(0x08001234);
+
+    gsys_crash_dump_t dump = {};
+    EXPECT_FALSE(system_crash_dump_get(NULL));
+    ASSERT_TRUE(system_crash_dump_get(&dump));
+    EXPECT_EQ(dump.fault, (uint32_t)HARD_FAULT);
+    EXPECT_EQ(dump.pc, 0x08001234U);
+    EXPECT_EQ(dump.lr, 0x08000201U);
+    EXPECT_EQ(dump.job_id, 3U);
+    EXPECT_EQ(dump.stack_words, 2U);
+    EXPECT_EQ(dump.stack[0], 0xDEADBEEFU);
+    EXPECT_TRUE(sys_crash_dump_pending());
+
+    // The cleared magic drops the record
+    system_crash_dump_clear();
+    EXPECT_FALSE(system_crash_dump_get(&dump));
+    EXPECT_FALSE(sys_crash_dump_pending());
+}
+
+TEST_F(CrashTest, TornRecordIsRejected)
+{
+    gsys_crash_dump_t dump = {};
+
+    // A reset in the middle of the capture: the record isn't sealed
+    gsys_crash_dump_t* torn = sys_crash_dump_begin();
+    torn->fault = BUS_FAULT;
+    torn->pc    = 0x08004321;
+    EXPECT_FALSE(system_crash_dump_get(&dump));
+    EXPECT_FALSE(sys_crash_dump_pending());
+
+    // A word changed after the seal breaks the hash
+    gsys_crash_dump_t* sealed = capture(0x08001234);
+    ASSERT_TRUE(system_crash_dump_get(&dump));
+    sealed->stack[1] ^= 1;
+    EXPECT_FALSE(system_crash_dump_get(&dump));
+    EXPECT_FALSE(sys_crash_dump_pending());
+
+    // Nothing is flushed from the broken record
+    crash_dump_flush();
+    EXPECT_FALSE(system_crash_dump_get(&dump));
+}
+
+TEST_F(CrashTest, StoredRecordIsFlushedOnce)
+{
+    capture(0x08001234);
+    gsys_crash_dump_t before = {};
+    ASSERT_TRUE(system_crash_dump_get(&before));
+    ASSERT_TRUE(sys_crash_dump_pending());
+
+    // The flush marks the record stored and keeps it valid for system_crash_dump_get()
+    crash_dump_flush();
+    EXPECT_FALSE(sys_crash_dump_pending());
+    gsys_crash_dump_t after = {};
+    ASSERT_TRUE(system_crash_dump_get(&after));
+    EXPECT_EQ(memcmp(&before, &after, sizeof(before)), 0);
+
+    // The next flush job launches find nothing to store
+    crash_dump_flush();
+    EXPECT_FALSE(sys_crash_dump_pending());
+    ASSERT_TRUE(system_crash_dump_get(&after));
+    EXPECT_EQ(memcmp(&before, &after, sizeof(before)), 0);
+
+    // A new crash is stored again
+    capture(0x08005678);
+    EXPECT_TRUE(sys_crash_dump_pending());
+    crash_dump_flush();
+    EXPECT_FALSE(sys_crash_dump_pending());
+}
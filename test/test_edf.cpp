@@ -0,0 +1,169 @@
+/*
+ * @file test_edf.cpp
+ * @brief EDF tier tests (GSYSTEM_SCHEDULER_EDF): the utilization admission,
+ *        the earliest-deadline-first launch order and the deadline misses.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_jobs_init();
+
+
+static constexpr uint32_t PERIOD_MS = 100;
+
+static std::vector<unsigned> run_order;
+
+template<unsigned N, uint32_t EXEC_US>
+static void edf_job()
+{
+    run_order.push_back(N);
+    system_delay_us(EXEC_US);
+}
+
+
+class EdfTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        host_set_time_us(0);
+        sys_jobs_init();
+    }
+
+    void SetUp() override
+    {
+        run_order.clear();
+    }
+
+    static uint32_t edf_load_x100()
+    {
+        gsys_scheduler_stats_t stats = {};
+        EXPECT_TRUE(system_get_scheduler_stats(&stats));
+        return stats.edf_load_x100;
+    }
+
+    static uint32_t deadline_misses(gsys_job_t job)
+    {
+        gsys_job_stats_t stats = {};
+        EXPECT_TRUE(system_get_job_stats(job, &stats));
+        return stats.deadline_misses;
+    }
+
+    /* @brief Move the time to the next period boundary, the release time of the jobs with the pinned zero phase */
+    static uint64_t advance_to_release(uint64_t period_us)
+    {
+        uint64_t now_us = system_micros();
+        uint64_t release_us = now_us - now_us % period_us + period_us;
+        host_advance_us(release_us - now_us);
+        return release_us;
+    }
+};
+
+
+TEST_F(EdfTest, AdmissionKeepsTheUtilizationBound)
+{
+    ASSERT_EQ(edf_load_x100(), 0U);
+
+    // 40% + 25% fit into the default 70% bound
+    gsys_job_t first  = system_register_rt(edf_job<0, 0>, 10, 4000, 0, true);
+    gsys_job_t second = system_register_rt(edf_job<1, 0>, 10, 2500, 0, true);
+    ASSERT_NE(first, GSYS_JOB_INVALID);
+    ASSERT_NE(second, GSYS_JOB_INVALID);
+    EXPECT_EQ(edf_load_x100(), 6500U);
+
+    // 10% more is over the bound, the load isn't changed by the rejected job
+    EXPECT_EQ(system_register_rt(edf_job<2, 0>, 10, 1000, 0, true), GSYS_JOB_INVALID);
+    EXPECT_EQ(edf_load_x100(), 6500U);
+
+    // The density counts the deadline shorter than the period: 1 ms of 2 ms is 50%
+    EXPECT_EQ(system_register_rt(edf_job<2, 0>, 100, 1000, 2, true), GSYS_JOB_INVALID);
+
+    // A removed job frees its share
+    EXPECT_TRUE(system_job_remove(second));
+    EXPECT_EQ(edf_load_x100(), 4000U);
+    gsys_job_t third = system_register_rt(edf_job<2, 0>, 10, 1000, 0, true);
+    EXPECT_NE(third, GSYS_JOB_INVALID);
+    EXPECT_EQ(edf_load_x100(), 5000U);
+
+    EXPECT_TRUE(system_job_remove(first));
+    EXPECT_TRUE(system_job_remove(third));
+    EXPECT_EQ(edf_load_x100(), 0U);
+}
+
+TEST_F(EdfTest, ReleasedJobsRunInDeadlineOrder)
+{
+    static constexpr uint32_t EXEC_US = 500;
+
+    // Registration order is the reverse of the deadline order
+    const uint32_t deadlines_ms[] = {90, 10, 50};
+    gsys_job_t jobs[] = {
+        system_register_rt(edf_job<0, EXEC_US>, PERIOD_MS, 1000, deadlines_ms[0], true),
+        system_register_rt(edf_job<1, EXEC_US>, PERIOD_MS, 1000, deadlines_ms[1], true),
+        system_register_rt(edf_job<2, EXEC_US>, PERIOD_MS, 1000, deadlines_ms[2], true),
+    };
+    for (gsys_job_t job : jobs) {
+        ASSERT_NE(job, GSYS_JOB_INVALID);
+        // One release time for all the jobs
+        ASSERT_TRUE(system_job_set_phase(job, 0));
+    }
+
+    for (unsigned period = 0; period < 3; period++) {
+        advance_to_release((uint64_t)PERIOD_MS * MILLIS_US);
+        system_tick();
+        ASSERT_EQ(run_order.size(), 3U * (period + 1)) << "period " << period;
+        EXPECT_EQ(run_order[3 * period + 0], 1U) << "period " << period;
+        EXPECT_EQ(run_order[3 * period + 1], 2U) << "period " << period;
+        EXPECT_EQ(run_order[3 * period + 2], 0U) << "period " << period;
+    }
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_EQ(deadline_misses(job), 0U);
+        EXPECT_TRUE(system_job_remove(job));
+    }
+}
+
+TEST_F(EdfTest, LateLaunchCountsTheDeadlineMisses)
+{
+    static constexpr uint32_t JOB_PERIOD_MS = 10;
+    static constexpr uint32_t DEADLINE_MS   = 2;
+
+    gsys_job_t job = system_register_rt(edf_job<0, 100>, JOB_PERIOD_MS, 500, DEADLINE_MS, true);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    ASSERT_TRUE(system_job_set_phase(job, 0));
+
+    // In time: no misses
+    uint64_t release_us = advance_to_release((uint64_t)JOB_PERIOD_MS * MILLIS_US);
+    system_tick();
+    ASSERT_EQ(run_order.size(), 1U);
+    EXPECT_EQ(deadline_misses(job), 0U);
+
+    // The main loop is blocked past the deadline of the next release
+    release_us += JOB_PERIOD_MS * MILLIS_US;
+    host_advance_us(release_us + (DEADLINE_MS + 1) * MILLIS_US - system_micros());
+    system_tick();
+    ASSERT_EQ(run_order.size(), 2U);
+    EXPECT_EQ(deadline_misses(job), 1U);
+
+    // Blocked over two more periods: the late launch and the two skipped releases
+    release_us += JOB_PERIOD_MS * MILLIS_US;
+    host_advance_us(release_us + (2 * JOB_PERIOD_MS + DEADLINE_MS + 1) * MILLIS_US - system_micros());
+    system_tick();
+    ASSERT_EQ(run_order.size(), 3U);
+    EXPECT_EQ(deadline_misses(job), 4U);
+
+    // The next launch keeps the period boundary and meets its deadline
+    release_us += 3 * JOB_PERIOD_MS * MILLIS_US;
+    host_advance_us(release_us - system_micros());
+    system_tick();
+    ASSERT_EQ(run_order.size(), 4U);
+    EXPECT_EQ(deadline_misses(job), 4U);
+
+    EXPECT_TRUE(system_job_remove(job));
+}
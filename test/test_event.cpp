@@ -0,0 +1,138 @@
+/*
+ * @file test_event.cpp
+ * @brief Event broker tests: the delivery through the post queue, the
+ *        event pool exhaustion and the reset event of system_reset().
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_post_drain();
+extern "C" bool sys_post_empty();
+
+
+struct Delivery {
+    uint16_t    topic;
+    uint32_t    value;
+    uint32_t    arg;
+    const void* data;
+    uint32_t    before_reset_calls;
+    uint32_t    reboot_calls;
+};
+
+static std::vector<Delivery> deliveries;
+
+static void record_event(const gsys_event_t* event)
+{
+    deliveries.push_back({
+        event->topic,
+        event->value,
+        event->arg,
+        event->data,
+        host_before_reset_calls,
+        host_reboot_calls,
+    });
+}
+
+
+class EventTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        deliveries.clear();
+        host_event_hook = record_event;
+    }
+
+    void TearDown() override
+    {
+        sys_post_drain();
+        host_event_hook = nullptr;
+    }
+
+    /* @brief Publish the user events until the pool is full, returns the number of published events */
+    static uint32_t publish_until_full()
+    {
+        uint32_t published = 0;
+        while (published <= GSYSTEM_EVENT_POOL_SIZE &&
+               system_event_publish(GSYS_EVENT_USER, published, 0, nullptr)) {
+            published++;
+        }
+        return published;
+    }
+};
+
+
+TEST_F(EventTest, DeliveredThroughThePostQueue)
+{
+    static const uint8_t payload[] = {1, 2, 3};
+
+    ASSERT_TRUE(system_event_publish(GSYS_EVENT_USER, 7, sizeof(payload), payload));
+
+    // Nothing is called from the publisher, the event waits in the post queue
+    EXPECT_TRUE(deliveries.empty());
+    EXPECT_FALSE(sys_post_empty());
+
+    sys_post_drain();
+    ASSERT_EQ(deliveries.size(), 1U);
+    EXPECT_EQ(deliveries[0].topic, GSYS_EVENT_USER);
+    EXPECT_EQ(deliveries[0].value, 7U);
+    EXPECT_EQ(deliveries[0].arg, sizeof(payload));
+    EXPECT_EQ(deliveries[0].data, payload);
+    EXPECT_TRUE(sys_post_empty());
+}
+
+TEST_F(EventTest, TopicWithoutSubscribersIsDropped)
+{
+    ASSERT_TRUE(system_event_publish(GSYS_EVENT_BUTTON, GSYS_BUTTON_PRESSED, 0, nullptr));
+    EXPECT_TRUE(sys_post_empty());
+    sys_post_drain();
+    EXPECT_TRUE(deliveries.empty());
+}
+
+TEST_F(EventTest, PoolExhaustionAndRelease)
+{
+    // The pool is full before the post queue
+    ASSERT_LT(GSYSTEM_EVENT_POOL_SIZE, GSYSTEM_POST_QUEUE_SIZE);
+    EXPECT_EQ(publish_until_full(), (uint32_t)GSYSTEM_EVENT_POOL_SIZE);
+    EXPECT_FALSE(system_event_publish(GSYS_EVENT_USER, 0, 0, nullptr));
+
+    // Every pooled event is delivered once in the publish order
+    sys_post_drain();
+    ASSERT_EQ(deliveries.size(), (size_t)GSYSTEM_EVENT_POOL_SIZE);
+    for (uint32_t i = 0; i < GSYSTEM_EVENT_POOL_SIZE; i++) {
+        EXPECT_EQ(deliveries[i].value, i) << "event " << i;
+    }
+
+    // The delivery frees the whole pool
+    deliveries.clear();
+    EXPECT_EQ(publish_until_full(), (uint32_t)GSYSTEM_EVENT_POOL_SIZE);
+    sys_post_drain();
+    EXPECT_EQ(deliveries.size(), (size_t)GSYSTEM_EVENT_POOL_SIZE);
+}
+
+TEST_F(EventTest, ResetPublishesTheResetEvent)
+{
+    // The deferred work posted before the reset is delivered as well
+    ASSERT_TRUE(system_event_publish(GSYS_EVENT_USER, 1, 0, nullptr));
+    uint32_t before_reset_calls = host_before_reset_calls;
+    uint32_t reboot_calls       = host_reboot_calls;
+
+    system_reset();
+
+    ASSERT_EQ(deliveries.size(), 2U);
+    EXPECT_EQ(deliveries[0].topic, GSYS_EVENT_USER);
+    EXPECT_EQ(deliveries[1].topic, GSYS_EVENT_RESET);
+    // The subscribers see the reset event before system_before_reset() and the reboot
+    EXPECT_EQ(deliveries[1].before_reset_calls, before_reset_calls);
+    EXPECT_EQ(deliveries[1].reboot_calls, reboot_calls);
+    EXPECT_EQ(host_before_reset_calls, before_reset_calls + 1);
+    EXPECT_EQ(host_reboot_calls, reboot_calls + 1);
+    EXPECT_TRUE(sys_post_empty());
+}
@@ -0,0 +1,187 @@
+/*
+ * @file test_hrt.cpp
+ * @brief High-resolution timer tests (GSYSTEM_HRT_TIMER) on the mocked
+ *        16-bit free running counter: the deadline order, the cancel, the
+ *        compare values across the counter wrap and the deadlines already
+ *        passed when the timer becomes the list head.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+struct Fire {
+    unsigned timer;
+    uint64_t at_us;
+};
+
+static std::vector<Fire> fires;
+
+static void record_fire(void* arg)
+{
+    EXPECT_NE(host_ipsr, 0U);
+    fires.push_back({(unsigned)(uintptr_t)arg, system_micros()});
+}
+
+static bool start(gsys_hrt_t* timer, unsigned n, uint32_t delay_us)
+{
+    return system_hrt_start(timer, delay_us, record_fire, (void*)(uintptr_t)n);
+}
+
+
+class HrtTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        fires.clear();
+    }
+
+    /* @brief Run the counter until its value, the interrupts on the way are handled */
+    static void advance_to_count(uint16_t count)
+    {
+        host_hrt_timer_advance_us((uint16_t)(count - g_hw_timer_count(GSYSTEM_HRT_TIMER)));
+    }
+};
+
+
+TEST_F(HrtTest, SortedInsertAndCancel)
+{
+    gsys_hrt_t timers[5] = {};
+    uint64_t start_us = system_micros();
+
+    // Out of order, the equal deadlines keep the start order
+    ASSERT_TRUE(start(&timers[0], 0, 300));
+    ASSERT_TRUE(start(&timers[1], 1, 100));
+    ASSERT_TRUE(start(&timers[2], 2, 200));
+    ASSERT_TRUE(start(&timers[3], 3, 200));
+    ASSERT_TRUE(start(&timers[4], 4, 250));
+    // The channel is programmed for the head
+    ASSERT_TRUE(host_hrt_compare_enabled);
+    EXPECT_EQ(host_hrt_compare, (uint16_t)(g_hw_timer_count(GSYSTEM_HRT_TIMER) + 100));
+
+    system_hrt_stop(&timers[4]);
+    EXPECT_FALSE(system_hrt_pending(&timers[4]));
+    EXPECT_TRUE(system_hrt_pending(&timers[0]));
+
+    host_hrt_timer_advance_us(1000);
+
+    const Fire expected[] = {{1, 100}, {2, 200}, {3, 200}, {0, 300}};
+    ASSERT_EQ(fires.size(), __arr_len(expected));
+    for (unsigned i = 0; i < __arr_len(expected); i++) {
+        EXPECT_EQ(fires[i].timer, expected[i].timer) << "fire " << i;
+        EXPECT_EQ(fires[i].at_us - start_us, expected[i].at_us) << "fire " << i;
+    }
+    for (gsys_hrt_t& timer : timers) {
+        EXPECT_FALSE(system_hrt_pending(&timer));
+    }
+    EXPECT_FALSE(host_hrt_compare_enabled);
+}
+
+TEST_F(HrtTest, CancelledHeadLeavesTheNextDeadline)
+{
+    gsys_hrt_t first = {};
+    gsys_hrt_t second = {};
+    uint64_t start_us = system_micros();
+    ASSERT_TRUE(start(&first, 0, 100));
+    ASSERT_TRUE(start(&second, 1, 400));
+
+    // The compare of the cancelled head is reprogrammed for the next timer
+    system_hrt_stop(&first);
+    host_hrt_timer_advance_us(1000);
+
+    ASSERT_EQ(fires.size(), 1U);
+    EXPECT_EQ(fires[0].timer, 1U);
+    EXPECT_EQ(fires[0].at_us - start_us, 400U);
+}
+
+TEST_F(HrtTest, CompareWrapsPastTheCounterEnd)
+{
+    static constexpr uint32_t DELAY_US = 0x80;
+
+    gsys_hrt_t timer = {};
+    ASSERT_TRUE(start(&timer, 0, 1));
+    host_hrt_timer_advance_us(1);
+    fires.clear();
+
+    advance_to_count(0xFFC0);
+    uint64_t start_us = system_micros();
+    ASSERT_TRUE(start(&timer, 0, DELAY_US));
+
+    // The compare value is past the 16-bit wrap, below the current counter
+    ASSERT_TRUE(host_hrt_compare_enabled);
+    EXPECT_EQ(host_hrt_compare, (uint16_t)(0xFFC0 + DELAY_US));
+    EXPECT_LT(host_hrt_compare, g_hw_timer_count(GSYSTEM_HRT_TIMER));
+
+    host_hrt_timer_advance_us(DELAY_US - 1);
+    EXPECT_TRUE(fires.empty());
+    host_hrt_timer_advance_us(1);
+    ASSERT_EQ(fires.size(), 1U);
+    EXPECT_EQ(fires[0].at_us - start_us, DELAY_US);
+}
+
+TEST_F(HrtTest, FarDeadlineOverSeveralCounterPeriods)
+{
+    static constexpr uint32_t DELAY_US = 200000;
+
+    gsys_hrt_t timer = {};
+    uint64_t start_us = system_micros();
+    ASSERT_TRUE(start(&timer, 0, DELAY_US));
+    // Too far for one counter period: the intermediate compares keep the counter extension
+    ASSERT_TRUE(host_hrt_compare_enabled);
+    EXPECT_EQ(host_hrt_compare, (uint16_t)(g_hw_timer_count(GSYSTEM_HRT_TIMER) + 0xF000));
+
+    host_hrt_timer_advance_us(DELAY_US - 1);
+    EXPECT_TRUE(fires.empty());
+    host_hrt_timer_advance_us(1);
+    ASSERT_EQ(fires.size(), 1U);
+    EXPECT_EQ(fires[0].at_us - start_us, DELAY_US);
+}
+
+TEST_F(HrtTest, PassedDeadlineFiresOnTheForcedCompare)
+{
+    gsys_hrt_t late = {};
+    gsys_hrt_t head = {};
+    uint32_t forced = host_hrt_forced_compares;
+
+    // A zero delay is already due: the software raised compare calls it at once
+    uint64_t start_us = system_micros();
+    ASSERT_TRUE(start(&late, 0, 0));
+    EXPECT_EQ(host_hrt_forced_compares, forced + 1);
+    ASSERT_EQ(fires.size(), 1U);
+    EXPECT_EQ(fires[0].at_us, start_us);
+    EXPECT_FALSE(system_hrt_pending(&late));
+
+    // Started with the masked interrupts: the deadline passes before the interrupt
+    ASSERT_TRUE(start(&head, 1, 500));
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    ASSERT_TRUE(start(&late, 2, 10));
+    EXPECT_EQ(host_hrt_forced_compares, forced + 3);
+    EXPECT_EQ(fires.size(), 1U);
+    host_advance_us(50);
+
+    // On the unmask the pending interrupt finds the passed deadline and reprograms the channel for the next timer
+    __set_PRIMASK(primask);
+    ASSERT_EQ(fires.size(), 2U);
+    EXPECT_EQ(fires[1].timer, 2U);
+    EXPECT_EQ(fires[1].at_us - start_us, 50U);
+    ASSERT_TRUE(host_hrt_compare_enabled);
+    EXPECT_EQ(host_hrt_compare, (uint16_t)(g_hw_timer_count(GSYSTEM_HRT_TIMER) + 450));
+
+    // A later timer doesn't become the head: no software compare
+    gsys_hrt_t tail = {};
+    ASSERT_TRUE(start(&tail, 3, 1000));
+    EXPECT_EQ(host_hrt_forced_compares, forced + 3);
+
+    host_hrt_timer_advance_us(1000);
+    ASSERT_EQ(fires.size(), 4U);
+    EXPECT_EQ(fires[2].timer, 1U);
+    EXPECT_EQ(fires[2].at_us - start_us, 500U);
+    EXPECT_EQ(fires[3].timer, 3U);
+}
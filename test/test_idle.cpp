@@ -0,0 +1,156 @@
+/*
+ * @file test_idle.cpp
+ * @brief Tickless idle tests on the virtual clock: the sleep length, the
+ *        system time compensation and the wake up by the new work.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_jobs_init();
+extern "C" uint64_t sys_jobs_next_us();
+extern "C" uint64_t sys_twheel_next_ms();
+extern "C" bool sys_post_empty();
+
+
+static uint32_t fired = 0;
+static void count_fired(void*) { fired++; }
+
+static uint32_t added_launches = 0;
+static gsys_job_t added_job = GSYS_JOB_INVALID;
+static void added_task() { added_launches++; }
+static void add_job(void*) { added_job = system_register(added_task, 1, true, true, 100); }
+static void post_add_job() { EXPECT_TRUE(system_post(add_job, nullptr)); }
+
+
+class IdleTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        host_set_time_us(0);
+        sys_jobs_init();
+    }
+
+    void TearDown() override
+    {
+        host_sleep_wake_ms = 0;
+        host_sleep_irq     = nullptr;
+    }
+
+    static void run_ms(uint32_t ms)
+    {
+        for (uint32_t i = 0; i < ms; i++) {
+            host_advance_us(MILLIS_US);
+            system_tick();
+        }
+    }
+
+    /* @brief Tick until the nearest job is at least min_ms away, returns the idle time in ms */
+    static uint32_t run_until_idle_ms(uint32_t min_ms)
+    {
+        for (uint32_t i = 0; i < SECOND_MS; i++) {
+            uint32_t idle_ms = (uint32_t)((sys_jobs_next_us() - system_micros()) / MILLIS_US);
+            if (idle_ms >= min_ms) {
+                return idle_ms;
+            }
+            run_ms(1);
+        }
+        ADD_FAILURE() << "the system jobs never leave " << min_ms << " ms idle";
+        return 0;
+    }
+};
+
+
+TEST_F(IdleTest, SleepsUntilTheNextJob)
+{
+    uint32_t idle_ms = run_until_idle_ms(GSYSTEM_TICKLESS_MIN_MS);
+    ASSERT_TRUE(sys_post_empty());
+    ASSERT_EQ(sys_twheel_next_ms(), UINT64_MAX);
+
+    uint64_t next_us  = sys_jobs_next_us();
+    uint64_t start_us = system_micros();
+    uint32_t start_ms = system_millis();
+    uint32_t sleeps   = host_sleep_calls;
+
+    system_idle();
+
+    ASSERT_EQ(host_sleep_calls, sleeps + 1);
+    EXPECT_EQ(host_sleep_request_ms, idle_ms);
+    // The sleep ends on the job deadline millisecond, never after it
+    EXPECT_EQ(system_micros(), start_us + (uint64_t)idle_ms * MILLIS_US);
+    EXPECT_LE(system_micros(), next_us);
+    EXPECT_GT(system_micros() + MILLIS_US, next_us);
+    EXPECT_EQ(system_millis(), start_ms + idle_ms);
+}
+
+TEST_F(IdleTest, SleepsUntilTheNextWheelTimer)
+{
+    static constexpr uint32_t TIMER_MS = GSYSTEM_TICKLESS_MIN_MS;
+
+    run_until_idle_ms(TIMER_MS + 2);
+    gsys_wtimer_t timer = {};
+    fired = 0;
+    ASSERT_TRUE(system_wtimer_start(&timer, TIMER_MS, 0, count_fired, nullptr));
+    uint32_t start_ms = system_millis();
+    uint32_t sleeps   = host_sleep_calls;
+
+    system_idle();
+
+    ASSERT_EQ(host_sleep_calls, sleeps + 1);
+    EXPECT_EQ(host_sleep_request_ms, TIMER_MS);
+    EXPECT_EQ(system_millis(), start_ms + TIMER_MS);
+    system_tick();
+    EXPECT_EQ(fired, 1U);
+    EXPECT_FALSE(system_wtimer_active(&timer));
+}
+
+TEST_F(IdleTest, PendingPostSkipsTheSleep)
+{
+    run_until_idle_ms(GSYSTEM_TICKLESS_MIN_MS);
+    fired = 0;
+    ASSERT_TRUE(system_post(count_fired, nullptr));
+    uint64_t start_us = system_micros();
+    uint32_t sleeps   = host_sleep_calls;
+
+    system_idle();
+
+    EXPECT_EQ(host_sleep_calls, sleeps);
+    EXPECT_EQ(system_micros(), start_us);
+    system_tick();
+    EXPECT_EQ(fired, 1U);
+}
+
+TEST_F(IdleTest, JobAddedDuringTheSleepWakesTheLoop)
+{
+    static constexpr uint32_t WAKE_MS = 1;
+
+    uint32_t idle_ms = run_until_idle_ms(WAKE_MS + 3);
+    uint64_t planned_wake_us = system_micros() + (uint64_t)idle_ms * MILLIS_US;
+    uint32_t start_ms = system_millis();
+
+    // An interrupt posts the registration of a new 1 ms job in the middle of the sleep
+    host_sleep_wake_ms = WAKE_MS;
+    host_sleep_irq     = post_add_job;
+    system_idle();
+
+    EXPECT_EQ(host_sleep_request_ms, idle_ms);
+    EXPECT_EQ(system_millis(), start_ms + WAKE_MS);
+    EXPECT_EQ(added_job, GSYS_JOB_INVALID);
+
+    system_tick();
+    ASSERT_NE(added_job, GSYS_JOB_INVALID);
+    EXPECT_LT(sys_jobs_next_us(), planned_wake_us);
+
+    // The new job runs before the end of the interrupted sleep
+    while (system_micros() + MILLIS_US < planned_wake_us) {
+        system_idle();
+        run_ms(1);
+    }
+    EXPECT_GE(added_launches, 1U);
+    EXPECT_TRUE(system_job_remove(added_job));
+}
@@ -0,0 +1,209 @@
+/*
+ * @file test_isr.cpp
+ * @brief ISR tier tests on the virtual clock: the launch order of the
+ *        GSYSTEM_ISR_TIMER passes, the pass budget, the overruns and the
+ *        100 us periods.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_jobs_init();
+
+
+struct Launch {
+    unsigned job;
+    uint64_t at_us;
+};
+
+static std::vector<Launch> launch_log;
+
+template<unsigned N>
+static void isr_job()
+{
+    EXPECT_NE(host_ipsr, 0U);
+    launch_log.push_back({N, system_micros()});
+}
+
+template<unsigned N, uint32_t EXEC_US>
+static void slow_isr_job()
+{
+    launch_log.push_back({N, system_micros()});
+    system_delay_us(EXEC_US);
+}
+
+
+class IsrTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        host_set_time_us(0);
+        sys_jobs_init();
+    }
+
+    void SetUp() override
+    {
+        launch_log.clear();
+    }
+
+    /* @brief Fire the ISR timer until the given time, returns the number of interrupts */
+    static uint32_t fire_until(uint64_t end_us)
+    {
+        uint32_t fired = 0;
+        while (host_isr_timer_deadline_us <= end_us) {
+            host_isr_timer_fire();
+            fired++;
+        }
+        return fired;
+    }
+
+    static std::vector<uint64_t> launches_of(unsigned job)
+    {
+        std::vector<uint64_t> times;
+        for (const Launch& launch : launch_log) {
+            if (launch.job == job) {
+                times.push_back(launch.at_us);
+            }
+        }
+        return times;
+    }
+
+    static gsys_scheduler_stats_t scheduler_stats()
+    {
+        gsys_scheduler_stats_t stats = {};
+        EXPECT_TRUE(system_get_scheduler_stats(&stats));
+        return stats;
+    }
+};
+
+
+TEST_F(IsrTest, IdleTimerWaitsTheMaxRearmDelay)
+{
+    EXPECT_EQ(host_isr_timer_delay_us, 50 * MILLIS_US);
+}
+
+TEST_F(IsrTest, JobsRunInDeadlineOrderAtAbsolutePeriods)
+{
+    static constexpr uint32_t RUN_US = 10 * MILLIS_US;
+
+    const uint32_t periods_us[] = {100, 250, MILLIS_US};
+    gsys_job_t jobs[] = {
+        system_register_isr_us(isr_job<0>, periods_us[0], true),
+        system_register_isr_us(isr_job<1>, periods_us[1], true),
+        system_register_isr(isr_job<2>, 1, true, true, 100),
+    };
+    for (gsys_job_t job : jobs) {
+        ASSERT_NE(job, GSYS_JOB_INVALID);
+    }
+    uint64_t start_us = system_micros();
+    // The timer is armed for the nearest job
+    EXPECT_EQ(host_isr_timer_delay_us, periods_us[0]);
+
+    fire_until(start_us + RUN_US);
+
+    for (size_t i = 1; i < launch_log.size(); i++) {
+        EXPECT_LE(launch_log[i - 1].at_us, launch_log[i].at_us) << "launch " << i;
+    }
+    for (unsigned j = 0; j < __arr_len(jobs); j++) {
+        std::vector<uint64_t> times = launches_of(j);
+        ASSERT_EQ(times.size(), RUN_US / periods_us[j]) << "job " << j;
+        for (size_t k = 0; k < times.size(); k++) {
+            EXPECT_EQ(times[k], start_us + (k + 1) * periods_us[j]) << "job " << j << " launch " << k;
+        }
+    }
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+    // The interrupt armed for the removed jobs finds nothing due and rearms the idle delay
+    uint32_t count = (uint32_t)launch_log.size();
+    host_isr_timer_fire();
+    EXPECT_EQ(launch_log.size(), count);
+    EXPECT_EQ(host_isr_timer_delay_us, 50 * MILLIS_US);
+}
+
+TEST_F(IsrTest, HundredMicrosecondPeriod)
+{
+    static constexpr uint32_t PERIOD_US = 100;
+    static constexpr uint32_t RUN_US    = 10 * MILLIS_US;
+
+    gsys_job_t job = system_register_isr_us(isr_job<0>, PERIOD_US, true);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+
+    // One interrupt per launch, no millisecond rounding of the period
+    EXPECT_EQ(fire_until(system_micros() + RUN_US), RUN_US / PERIOD_US);
+    std::vector<uint64_t> times = launches_of(0);
+    ASSERT_EQ(times.size(), RUN_US / PERIOD_US);
+    for (size_t k = 1; k < times.size(); k++) {
+        EXPECT_EQ(times[k] - times[k - 1], PERIOD_US) << "launch " << k;
+    }
+
+    gsys_job_stats_t stats = {};
+    ASSERT_TRUE(system_get_job_stats(job, &stats));
+    EXPECT_TRUE(stats.isr);
+    EXPECT_EQ(stats.period_us, PERIOD_US);
+    EXPECT_EQ(stats.period_ms, 1U);
+    EXPECT_EQ(stats.overruns, 0U);
+
+    EXPECT_TRUE(system_job_remove(job));
+}
+
+TEST_F(IsrTest, BudgetDefersTheRestOfTheDueJobs)
+{
+    static constexpr uint32_t SLOW_US = GSYSTEM_ISR_BUDGET_US + 10;
+
+    gsys_job_t slow = system_register_isr(slow_isr_job<0, SLOW_US>, 1, true, true, 100);
+    host_advance_us(10);
+    gsys_job_t fast = system_register_isr(isr_job<1>, 1, true, true, 100);
+    ASSERT_NE(slow, GSYS_JOB_INVALID);
+    ASSERT_NE(fast, GSYS_JOB_INVALID);
+    uint32_t budget_hits = scheduler_stats().isr_budget_hits;
+
+    // The slow job eats the pass budget, the due fast job waits for the next interrupt
+    host_isr_timer_fire();
+    uint64_t pass_end_us = system_micros();
+    EXPECT_EQ(launches_of(0).size(), 1U);
+    EXPECT_TRUE(launches_of(1).empty());
+    EXPECT_EQ(scheduler_stats().isr_budget_hits, budget_hits + 1);
+    EXPECT_EQ(host_isr_timer_delay_us, 1U);
+
+    host_isr_timer_fire();
+    ASSERT_EQ(launches_of(1).size(), 1U);
+    EXPECT_EQ(launches_of(1)[0], pass_end_us + 1);
+    EXPECT_EQ(scheduler_stats().isr_budget_hits, budget_hits + 1);
+
+    EXPECT_TRUE(system_job_remove(slow));
+    EXPECT_TRUE(system_job_remove(fast));
+}
+
+TEST_F(IsrTest, LongLaunchCountsTheMissedPeriods)
+{
+    static constexpr uint32_t PERIOD_US = 100;
+    static constexpr uint32_t EXEC_US   = 250;
+
+    gsys_job_t job = system_register_isr_us(slow_isr_job<0, EXEC_US>, PERIOD_US, true);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    uint64_t start_us = system_micros();
+
+    // Launch at +100 us ends at +350 us: the +200 and +300 us releases are missed
+    host_isr_timer_fire();
+    gsys_job_stats_t stats = {};
+    ASSERT_TRUE(system_get_job_stats(job, &stats));
+    EXPECT_EQ(stats.overruns, 2U);
+    EXPECT_EQ(host_isr_timer_deadline_us, start_us + 4 * PERIOD_US);
+
+    // The next launch keeps the absolute period boundary
+    host_isr_timer_fire();
+    std::vector<uint64_t> times = launches_of(0);
+    ASSERT_EQ(times.size(), 2U);
+    EXPECT_EQ(times[1], start_us + 4 * PERIOD_US);
+
+    EXPECT_TRUE(system_job_remove(job));
+}
@@ -0,0 +1,176 @@
+/*
+ * @file test_post.cpp
+ * @brief system_post() ring tests: order, overflow and concurrent producers.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_post_drain();
+extern "C" bool sys_post_empty();
+
+
+static std::vector<uintptr_t> delivered;
+
+static void collect(void* arg)
+{
+    delivered.push_back((uintptr_t)arg);
+}
+
+static void repost(void* arg)
+{
+    delivered.push_back((uintptr_t)arg);
+    EXPECT_TRUE(system_post(collect, (void*)((uintptr_t)arg + 1)));
+}
+
+
+class PostTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        while (!sys_post_empty()) {
+            sys_post_drain();
+        }
+        delivered.clear();
+    }
+};
+
+
+TEST_F(PostTest, DeliversInOrder)
+{
+    for (uintptr_t i = 0; i < 10; i++) {
+        ASSERT_TRUE(system_post(collect, (void*)i));
+    }
+    EXPECT_FALSE(sys_post_empty());
+    sys_post_drain();
+    EXPECT_TRUE(sys_post_empty());
+
+    ASSERT_EQ(delivered.size(), 10U);
+    for (uintptr_t i = 0; i < 10; i++) {
+        EXPECT_EQ(delivered[i], i);
+    }
+}
+
+TEST_F(PostTest, RejectsEmptyCallback)
+{
+    EXPECT_FALSE(system_post(NULL, NULL));
+    EXPECT_TRUE(sys_post_empty());
+}
+
+TEST_F(PostTest, DropsOnOverflow)
+{
+    // Wraps the ring a few times
+    for (int round = 0; round < 5; round++) {
+        delivered.clear();
+        for (uintptr_t i = 0; i < GSYSTEM_POST_QUEUE_SIZE; i++) {
+            ASSERT_TRUE(system_post(collect, (void*)i));
+        }
+        EXPECT_FALSE(system_post(collect, (void*)0xFF));
+        sys_post_drain();
+        ASSERT_EQ(delivered.size(), (size_t)GSYSTEM_POST_QUEUE_SIZE);
+        EXPECT_EQ(delivered.back(), (uintptr_t)GSYSTEM_POST_QUEUE_SIZE - 1);
+    }
+}
+
+TEST_F(PostTest, PostFromCallbackWaitsForNextDrain)
+{
+    ASSERT_TRUE(system_post(repost, (void*)100));
+    sys_post_drain();
+    ASSERT_EQ(delivered.size(), 1U);
+    EXPECT_FALSE(sys_post_empty());
+    sys_post_drain();
+    ASSERT_EQ(delivered.size(), 2U);
+    EXPECT_EQ(delivered[1], 101U);
+}
+
+/*
+ * Producers on several threads stand for interrupt handlers of different
+ * priorities, every accepted post is delivered once.
+ */
+TEST_F(PostTest, ConcurrentProducers)
+{
+    static constexpr unsigned PRODUCERS = 4;
+    static constexpr uintptr_t PER_PRODUCER = 20000;
+
+    std::atomic<unsigned> running(PRODUCERS);
+    std::atomic<uint32_t> accepted[PRODUCERS] = {};
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([p, &running, &accepted] {
+            for (uintptr_t i = 0; i < PER_PRODUCER; i++) {
+                if (system_post(collect, (void*)((p << 24) | i))) {
+                    accepted[p]++;
+                }
+            }
+            running--;
+        });
+    }
+
+    while (running || !sys_post_empty()) {
+        sys_post_drain();
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    sys_post_drain();
+
+    uint32_t total = 0;
+    std::vector<uintptr_t> last(PRODUCERS, 0);
+    std::vector<uint32_t> received(PRODUCERS, 0);
+    for (uintptr_t value : delivered) {
+        unsigned p = (unsigned)(value >> 24);
+        ASSERT_LT(p, PRODUCERS);
+        uintptr_t i = value & 0xFFFFFF;
+        // Posts of one producer keep their order
+        if (received[p]) {
+            EXPECT_GT(i, last[p]);
+        }
+        last[p] = i;
+        received[p]++;
+    }
+    for (unsigned p = 0; p < PRODUCERS; p++) {
+        EXPECT_EQ(received[p], accepted[p].load());
+        total += received[p];
+    }
+    EXPECT_EQ(total, (uint32_t)delivered.size());
+    EXPECT_GT(total, 0U);
+}
+
+static void drain_inside(void* arg)
+{
+    delivered.push_back((uintptr_t)arg);
+    EXPECT_TRUE(system_post(collect, (void*)((uintptr_t)arg + 1)));
+    // Re-entered drain (system_reset() or a yield from the callback) is skipped
+    sys_post_drain();
+    EXPECT_EQ(delivered.size(), 1U);
+}
+
+TEST_F(PostTest, DrainIsNotReentered)
+{
+    ASSERT_TRUE(system_post(drain_inside, (void*)200));
+    sys_post_drain();
+    ASSERT_EQ(delivered.size(), 1U);
+    sys_post_drain();
+    ASSERT_EQ(delivered.size(), 2U);
+    EXPECT_EQ(delivered[1], 201U);
+}
+
+TEST_F(PostTest, NoDrainFromInterruptHandler)
+{
+    ASSERT_TRUE(system_post(collect, (void*)300));
+    host_ipsr = 15;
+    sys_post_drain();
+    host_ipsr = 0;
+    EXPECT_TRUE(delivered.empty());
+    sys_post_drain();
+    ASSERT_EQ(delivered.size(), 1U);
+}
@@ -0,0 +1,713 @@
+/*
+ * @file test_proc.cpp
+ * @brief Scheduler job queue tests and the tick cost benchmark.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "soul.h"
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_jobs_init();
+
+
+static constexpr uint32_t SLEEP_PERIOD_MS = MINUTE_MS;
+
+static uint32_t launches[3] = {};
+static uint64_t last_launch_us[3] = {};
+
+static void job_3ms() { launches[0]++; last_launch_us[0] = system_micros(); }
+static void job_5ms() { launches[1]++; last_launch_us[1] = system_micros(); }
+static void job_7ms() { launches[2]++; last_launch_us[2] = system_micros(); }
+
+static uint32_t sleeping_launches = 0;
+static void sleeping_job() { sleeping_launches++; }
+
+static std::vector<uint64_t> phase_launches[4];
+
+template<unsigned N>
+static void phase_job()
+{
+    phase_launches[N].push_back(system_micros());
+}
+
+
+class ProcTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        host_set_time_us(0);
+        sys_jobs_init();
+    }
+
+    static void run_ms(uint32_t ms)
+    {
+        for (uint32_t i = 0; i < ms; i++) {
+            host_advance_us(MILLIS_US);
+            system_tick();
+        }
+    }
+
+    /* @brief Average scheduler pass cost in nanoseconds, the system time is frozen */
+    static double pass_cost_ns(uint32_t passes)
+    {
+        double best = 0;
+        for (int run = 0; run < 5; run++) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < passes; i++) {
+                system_tick();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / passes;
+            if (!run || ns < best) {
+                best = ns;
+            }
+        }
+        return best;
+    }
+};
+
+
+TEST_F(ProcTest, DueJobsAreLaunchedOncePerPeriod)
+{
+    gsys_job_t jobs[] = {
+        system_register(job_3ms, 3, true, true, 100),
+        system_register(job_5ms, 5, true, true, 100),
+        system_register(job_7ms, 7, true, true, 100),
+    };
+    for (gsys_job_t job : jobs) {
+        ASSERT_NE(job, GSYS_JOB_INVALID);
+    }
+
+    const uint32_t periods[] = {3, 5, 7};
+    const uint32_t run_time_ms = 3 * 5 * 7;
+    run_ms(run_time_ms);
+
+    for (unsigned i = 0; i < 3; i++) {
+        // The first launch is staggered up to one period
+        EXPECT_GE(launches[i], run_time_ms / periods[i] - 1) << "job " << i;
+        EXPECT_LE(launches[i], run_time_ms / periods[i]) << "job " << i;
+    }
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+}
+
+TEST_F(ProcTest, SleepingJobsAreNotTouched)
+{
+    std::vector<gsys_job_t> jobs;
+    for (unsigned i = 0; i < 32; i++) {
+        jobs.push_back(system_register(sleeping_job, SLEEP_PERIOD_MS, true, true, 100));
+        ASSERT_NE(jobs.back(), GSYS_JOB_INVALID);
+    }
+    uint32_t fast = launches[0];
+    gsys_job_t fast_job = system_register(job_3ms, 3, true, true, 100);
+
+    run_ms(SECOND_MS);
+
+    EXPECT_EQ(sleeping_launches, 0U);
+    EXPECT_GE(launches[0] - fast, SECOND_MS / 3 - 1);
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+    EXPECT_TRUE(system_job_remove(fast_job));
+}
+
+TEST_F(ProcTest, JobStatsByHandle)
+{
+    gsys_job_t job = system_register(job_3ms, 3, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+
+    gsys_job_stats_t stats = {};
+    ASSERT_TRUE(system_get_job_stats(job, &stats));
+    EXPECT_EQ(stats.action, (uint32_t)(uintptr_t)job_3ms);
+    EXPECT_EQ(stats.period_ms, 3U);
+    EXPECT_TRUE(stats.realtime);
+
+    EXPECT_FALSE(system_get_job_stats(GSYS_JOB_INVALID, &stats));
+    EXPECT_TRUE(system_job_remove(job));
+    EXPECT_FALSE(system_get_job_stats(job, &stats));
+    EXPECT_FALSE(system_job_set_phase(job, 1));
+}
+
+TEST_F(ProcTest, SuspendedJobIsNotLaunched)
+{
+    launches[0] = 0;
+    gsys_job_t job = system_register(job_3ms, 3, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    run_ms(30);
+    EXPECT_GE(launches[0], 9U);
+
+    ASSERT_TRUE(system_job_suspend(job));
+    EXPECT_TRUE(system_job_is_suspended(job));
+    uint32_t suspended_launches = launches[0];
+    run_ms(SECOND_MS);
+    EXPECT_EQ(launches[0], suspended_launches);
+
+    EXPECT_TRUE(system_job_remove(job));
+}
+
+/*
+ * A resumed job starts one period after the resume: the periods missed
+ * during the suspension are not launched in a burst.
+ */
+TEST_F(ProcTest, ResumedJobGetsAFreshPeriod)
+{
+    static constexpr uint32_t PERIOD_MS = 10;
+
+    gsys_job_t job = system_register(phase_job<0>, PERIOD_MS, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    run_ms(3 * PERIOD_MS);
+    ASSERT_TRUE(system_job_suspend(job));
+    run_ms(SECOND_MS);
+    phase_launches[0].clear();
+
+    uint64_t resume_us = system_micros();
+    ASSERT_TRUE(system_job_resume(job));
+    EXPECT_FALSE(system_job_is_suspended(job));
+    run_ms(PERIOD_MS - 1);
+    EXPECT_TRUE(phase_launches[0].empty());
+
+    run_ms(9 * PERIOD_MS + 1);
+    ASSERT_EQ(phase_launches[0].size(), 10U);
+    EXPECT_EQ(phase_launches[0][0], resume_us + PERIOD_MS * MILLIS_US);
+    for (size_t n = 1; n < phase_launches[0].size(); n++) {
+        EXPECT_EQ(phase_launches[0][n] - phase_launches[0][n - 1], PERIOD_MS * MILLIS_US) << "launch " << n;
+    }
+
+    EXPECT_TRUE(system_job_remove(job));
+    phase_launches[0].clear();
+}
+
+static std::vector<unsigned> run_order;
+
+template<unsigned N>
+static void ordered_job()
+{
+    run_order.push_back(N);
+}
+
+/* Of the jobs due at the same time the lower priority value runs first */
+TEST_F(ProcTest, PriorityChangeReordersTheRunOrder)
+{
+    static constexpr uint32_t PERIOD_MS = 10;
+
+    gsys_job_t jobs[] = {
+        system_register(ordered_job<0>, PERIOD_MS, true, true, 100),
+        system_register(ordered_job<1>, PERIOD_MS, true, true, 150),
+    };
+    for (gsys_job_t job : jobs) {
+        ASSERT_NE(job, GSYS_JOB_INVALID);
+        ASSERT_TRUE(system_job_set_phase(job, 0));
+    }
+    run_order.clear();
+
+    run_ms(PERIOD_MS);
+    ASSERT_EQ(run_order, (std::vector<unsigned>{0, 1}));
+
+    // The queued job is reordered at once
+    ASSERT_TRUE(system_job_set_priority(jobs[0], 200));
+    run_order.clear();
+    run_ms(PERIOD_MS);
+    EXPECT_EQ(run_order, (std::vector<unsigned>{1, 0}));
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+}
+
+TEST_F(ProcTest, StaleHandleIsRejected)
+{
+    gsys_job_t stale = system_register(job_3ms, 3, true, true, 100);
+    ASSERT_NE(stale, GSYS_JOB_INVALID);
+    ASSERT_TRUE(system_job_remove(stale));
+
+    // The slot is reused with the next generation
+    gsys_job_t job = system_register(job_5ms, 5, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    ASSERT_EQ(job & 0xFF, stale & 0xFF);
+    ASSERT_NE(job, stale);
+
+    gsys_job_stats_t stats = {};
+    EXPECT_FALSE(system_job_suspend(stale));
+    EXPECT_FALSE(system_job_resume(stale));
+    EXPECT_FALSE(system_job_is_suspended(stale));
+    EXPECT_FALSE(system_job_set_period(stale, 10));
+    EXPECT_FALSE(system_job_set_priority(stale, 150));
+    EXPECT_FALSE(system_job_set_phase(stale, 1));
+    EXPECT_FALSE(system_get_job_stats(stale, &stats));
+    EXPECT_FALSE(system_job_remove(stale));
+
+    // The new job is untouched by the stale calls
+    ASSERT_TRUE(system_get_job_stats(job, &stats));
+    EXPECT_EQ(stats.action, (uint32_t)(uintptr_t)job_5ms);
+    EXPECT_EQ(stats.period_ms, 5U);
+    EXPECT_EQ(stats.priority, 100U);
+    EXPECT_FALSE(system_job_is_suspended(job));
+    EXPECT_TRUE(system_job_remove(job));
+}
+
+TEST_F(ProcTest, SchedulerStatsCountTheJobs)
+{
+    EXPECT_FALSE(system_get_scheduler_stats(NULL));
+
+    gsys_scheduler_stats_t before = {};
+    ASSERT_TRUE(system_get_scheduler_stats(&before));
+    gsys_job_t jobs[] = {
+        system_register(job_3ms, 3, true, true, 100),
+        system_register(job_5ms, 5, true, true, 100),
+    };
+    run_ms(SECOND_MS + 1);
+
+    gsys_scheduler_stats_t stats = {};
+    ASSERT_TRUE(system_get_scheduler_stats(&stats));
+    EXPECT_EQ(stats.jobs_count, before.jobs_count + 2);
+    EXPECT_GT(stats.target_load_x100, 0U);
+    EXPECT_GT(stats.jobs_scale_x100, 0U);
+    // One pass per millisecond
+    EXPECT_NEAR(stats.ticks_per_second, SECOND_MS, 2);
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+    ASSERT_TRUE(system_get_scheduler_stats(&stats));
+    EXPECT_EQ(stats.jobs_count, before.jobs_count);
+}
+
+static void busy_1ms_job() { system_delay_us(MILLIS_US); }
+
+/*
+ * The load of an idle job decays by 10% per 200 ms scaling recompute after
+ * a second without launches, whatever the main loop pass rate is.
+ */
+TEST_F(ProcTest, IdleJobLoadDecay)
+{
+    gsys_job_t job = system_register(busy_1ms_job, 10, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    run_ms(2 * SECOND_MS);
+
+    auto load_x100 = [job]() {
+        gsys_job_stats_t stats = {};
+        EXPECT_TRUE(system_get_job_stats(job, &stats));
+        return stats.load_x100;
+    };
+    uint32_t busy_x100 = load_x100();
+    EXPECT_NEAR(busy_x100, 1000U, 100U);
+
+    ASSERT_TRUE(system_job_suspend(job));
+    run_ms(SECOND_MS - 100);
+    EXPECT_EQ(load_x100(), busy_x100);
+
+    // ~10 recomputes after the first idle second
+    run_ms(2 * SECOND_MS + 100);
+    double low  = busy_x100 * 0.31;  // 0.9^11
+    double high = busy_x100 * 0.39;  // 0.9^9
+    EXPECT_GE(load_x100(), (uint32_t)low);
+    EXPECT_LE(load_x100(), (uint32_t)high);
+
+    EXPECT_TRUE(system_job_remove(job));
+}
+
+/*
+ * The snapshot wire format: the header, the scheduler record and a record
+ * per job slot, packed little endian (the sizes are fixed by the format).
+ */
+TEST_F(ProcTest, StatsSnapshotLayout)
+{
+    static constexpr uint32_t HEADER_SIZE    = 8;
+    static constexpr uint32_t SCHEDULER_SIZE = 18;
+    static constexpr uint32_t JOB_SIZE       = 40;
+
+    gsys_job_t job = system_register(job_3ms, 3, true, true, 120);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    run_ms(10);
+
+    uint32_t size = system_stats_snapshot(NULL, 0);
+    ASSERT_GE(size, HEADER_SIZE + SCHEDULER_SIZE + JOB_SIZE);
+    EXPECT_EQ((size - HEADER_SIZE - SCHEDULER_SIZE) % JOB_SIZE, 0U);
+
+    // Too small buffer: nothing is written
+    std::vector<uint8_t> buf(size, 0xA5);
+    EXPECT_EQ(system_stats_snapshot(buf.data(), size - 1), 0U);
+    for (uint8_t byte : buf) {
+        ASSERT_EQ(byte, 0xA5);
+    }
+
+    ASSERT_EQ(system_stats_snapshot(buf.data(), size), size);
+    auto read32 = [&buf](uint32_t offset) { uint32_t value = 0; memcpy(&value, &buf[offset], sizeof(value)); return value; };
+    auto read16 = [&buf](uint32_t offset) { uint16_t value = 0; memcpy(&value, &buf[offset], sizeof(value)); return value; };
+
+    EXPECT_EQ(memcmp(buf.data(), "GSTS", 4), 0);
+    EXPECT_EQ(read16(4), 2U);
+    uint16_t count = read16(6);
+    EXPECT_EQ(size, HEADER_SIZE + SCHEDULER_SIZE + count * JOB_SIZE);
+
+    gsys_scheduler_stats_t sched = {};
+    ASSERT_TRUE(system_get_scheduler_stats(&sched));
+    EXPECT_EQ(read16(HEADER_SIZE + 4), sched.target_load_x100);
+    EXPECT_EQ(read32(HEADER_SIZE + 6), sched.jobs_scale_x100);
+    EXPECT_EQ(read32(HEADER_SIZE + 14), sched.isr_budget_hits);
+
+    // The record of the job slot
+    uint32_t slot = (job & 0xFF) - 1;
+    ASSERT_LT(slot, count);
+    uint32_t rec = HEADER_SIZE + SCHEDULER_SIZE + slot * JOB_SIZE;
+    EXPECT_EQ(read32(rec), (uint32_t)(uintptr_t)job_3ms);
+    EXPECT_EQ(read32(rec + 4), 3 * MILLIS_US);
+    EXPECT_EQ(read32(rec + 8), 3U);
+    EXPECT_EQ(buf[rec + 38], 120U);
+    EXPECT_EQ(buf[rec + 39], 0x01);
+
+    EXPECT_TRUE(system_job_remove(job));
+}
+
+static uint32_t timed_exec_us  = 0;
+static uint32_t timed_launches = 0;
+static void timed_job() { timed_launches++; system_delay_us(timed_exec_us); }
+
+/*
+ * Latency percentiles (GSYSTEM_PROC_HISTOGRAM): bucket k counts [2^(k-1), 2^k) us
+ * and reports its upper bound, the last bucket reports its lower bound.
+ */
+TEST_F(ProcTest, LatencyPercentiles)
+{
+    gsys_job_t job = system_register(timed_job, 1, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+    gsys_job_latency_t latency = {};
+    EXPECT_FALSE(system_job_latency(GSYS_JOB_INVALID, &latency));
+    EXPECT_FALSE(system_job_latency(job, NULL));
+
+    auto launch = [](uint32_t count, uint32_t exec_us) {
+        timed_exec_us = exec_us;
+        uint32_t target = timed_launches + count;
+        for (uint32_t i = 0; i < 100 * count && timed_launches < target; i++) {
+            run_ms(1);
+        }
+        ASSERT_EQ(timed_launches, target);
+    };
+    auto exec_p50_us = [job]() {
+        gsys_job_latency_t latency = {};
+        EXPECT_TRUE(system_job_latency(job, &latency));
+        return latency.exec_p50_us;
+    };
+
+    // 98 launches of 100 us and 2 of 5 ms: the tail is above the 99th percentile
+    system_job_latency_reset(job);
+    launch(98, 100);
+    launch(2, 5 * MILLIS_US);
+    ASSERT_TRUE(system_job_latency(job, &latency));
+    EXPECT_EQ(latency.exec_p50_us, 127U);
+    EXPECT_EQ(latency.exec_p99_us, 8191U);
+    EXPECT_EQ(latency.exec_p999_us, 8191U);
+    // The 1 ms passes launch the job less than a millisecond late
+    EXPECT_LE(latency.jitter_p50_us, 1023U);
+
+    // The bucket edges
+    const uint32_t edges[][2] = {
+        {0, 0},
+        {1, 1},
+        {127, 127},
+        {128, 255},
+        {65535, 65535},
+        {70000, 65536},
+    };
+    for (const auto& edge : edges) {
+        system_job_latency_reset(job);
+        EXPECT_EQ(exec_p50_us(), 0U);
+        launch(1, edge[0]);
+        EXPECT_EQ(exec_p50_us(), edge[1]) << edge[0] << " us";
+    }
+
+    EXPECT_TRUE(system_job_remove(job));
+    EXPECT_FALSE(system_job_latency(job, &latency));
+
+    // The next tests expect the time on the millisecond boundary
+    if (system_micros() % MILLIS_US) {
+        host_advance_us(MILLIS_US - system_micros() % MILLIS_US);
+    }
+}
+
+/*
+ * RAM of the scheduler tables: the hot job table with the queues and the
+ * statistics, pointers are twice as wide on the host as on the target.
+ */
+TEST_F(ProcTest, RamBudgetReport)
+{
+    gsys_scheduler_stats_t stats = {};
+    ASSERT_TRUE(system_get_scheduler_stats(&stats));
+
+    uint32_t slots = stats.jobs_count + GSYSTEM_POCESSES_COUNT;
+    printf("  jobs + queues: %u B, stats: %u B, %u slots max\n", stats.jobs_ram_bytes, stats.stats_ram_bytes, slots);
+    printf("  per slot     : %u B + %u B\n", stats.jobs_ram_bytes / slots, stats.stats_ram_bytes / slots);
+
+    EXPECT_GT(stats.jobs_ram_bytes, 0U);
+    EXPECT_GT(stats.stats_ram_bytes, 0U);
+    EXPECT_LE(stats.jobs_ram_bytes / slots, 96U);
+}
+
+static uint32_t due_launches = 0;
+static void due_job() { due_launches++; }
+
+/*
+ * Cost of a pass launching every job: the jobs are due on every 1 ms tick,
+ * so the pass touches the hot job fields and the queue of each one.
+ */
+TEST_F(ProcTest, DueJobsPassCost)
+{
+    static constexpr uint32_t JOBS   = 48;
+    static constexpr uint32_t PASSES = 2000;
+
+    std::vector<gsys_job_t> jobs;
+    for (uint32_t i = 0; i < JOBS; i++) {
+        jobs.push_back(system_register(due_job, 1, true, true, 100));
+        ASSERT_NE(jobs.back(), GSYS_JOB_INVALID);
+    }
+    run_ms(2);
+
+    due_launches = 0;
+    auto start = std::chrono::steady_clock::now();
+    run_ms(PASSES);
+    auto end = std::chrono::steady_clock::now();
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    printf("  %u due jobs: %.1f ns per pass, %.1f ns per launch\n", JOBS, ns / PASSES, ns / (PASSES * JOBS));
+    EXPECT_EQ(due_launches, JOBS * PASSES);
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+}
+
+/*
+ * The load recompute (every 200 ms) changes the job periods only, the
+ * launch phases spread by the scheduler are kept.
+ */
+TEST_F(ProcTest, StaggerSurvivesRecompute)
+{
+    static constexpr uint32_t PERIOD_MS = SECOND_MS;
+
+    run_ms(2 * SECOND_MS);
+    uint64_t start_us = system_micros();
+    gsys_job_t jobs[] = {
+        system_register(phase_job<0>, PERIOD_MS, false, true, 100),
+        system_register(phase_job<1>, PERIOD_MS, false, true, 100),
+        system_register(phase_job<2>, PERIOD_MS, false, true, 100),
+        system_register(phase_job<3>, PERIOD_MS, false, true, 100),
+    };
+
+    run_ms(5 * PERIOD_MS);
+
+    for (unsigned i = 0; i < __arr_len(jobs); i++) {
+        ASSERT_GE(phase_launches[i].size(), 3U) << "job " << i;
+        // The first launch is staggered inside the second period
+        EXPECT_GE(phase_launches[i][0], start_us + PERIOD_MS * MILLIS_US) << "job " << i;
+        EXPECT_LT(phase_launches[i][0], start_us + 2 * PERIOD_MS * MILLIS_US) << "job " << i;
+        for (unsigned j = 0; j < i; j++) {
+            EXPECT_NE(phase_launches[i][0], phase_launches[j][0]) << "jobs " << i << ", " << j;
+        }
+        for (size_t n = 1; n < phase_launches[i].size(); n++) {
+            EXPECT_EQ(phase_launches[i][n] - phase_launches[i][n - 1], PERIOD_MS * MILLIS_US) << "job " << i;
+        }
+        EXPECT_TRUE(system_job_remove(jobs[i]));
+        phase_launches[i].clear();
+    }
+}
+
+TEST_F(ProcTest, PinnedPhaseSurvivesRecompute)
+{
+    static constexpr uint32_t PERIOD_MS = SECOND_MS;
+    static constexpr uint32_t PHASE_MS  = 700;
+
+    gsys_job_t job = system_register(phase_job<0>, PERIOD_MS, false, true, 100);
+    run_ms(PERIOD_MS + PERIOD_MS / 2);
+    ASSERT_TRUE(system_job_set_phase(job, PHASE_MS));
+    phase_launches[0].clear();
+
+    run_ms(4 * PERIOD_MS);
+
+    ASSERT_GE(phase_launches[0].size(), 3U);
+    for (uint64_t launch_us : phase_launches[0]) {
+        EXPECT_EQ(launch_us % (PERIOD_MS * MILLIS_US), PHASE_MS * MILLIS_US);
+    }
+    EXPECT_TRUE(system_job_remove(job));
+    phase_launches[0].clear();
+}
+
+TEST_F(ProcTest, PeriodChangeKeepsPhase)
+{
+    gsys_job_t job = system_register(phase_job<0>, 100, false, true, 100);
+    run_ms(1000);
+    ASSERT_FALSE(phase_launches[0].empty());
+    uint64_t last_us = phase_launches[0].back();
+
+    // The queued launch is moved by the period change: last launch + the new period
+    ASSERT_TRUE(system_job_set_period(job, 300));
+    phase_launches[0].clear();
+    run_ms(1000);
+
+    ASSERT_GE(phase_launches[0].size(), 2U);
+    EXPECT_EQ(phase_launches[0][0], last_us + 300 * MILLIS_US);
+    EXPECT_EQ(phase_launches[0][1] - phase_launches[0][0], 300 * MILLIS_US);
+    EXPECT_TRUE(system_job_remove(job));
+    phase_launches[0].clear();
+}
+
+/*
+ * Pass cost with 40 due jobs: the pass takes one system state snapshot which
+ * is refreshed on the soul generation change only. The reference loop does
+ * the checks the pass did for each job before the snapshot.
+ */
+TEST_F(ProcTest, StateSnapshotPassCost)
+{
+    static constexpr uint32_t JOBS   = 40;
+    static constexpr uint32_t PASSES = 2000;
+
+    std::vector<gsys_job_t> jobs;
+    for (uint32_t i = 0; i < JOBS; i++) {
+        jobs.push_back(system_register(due_job, 1, true, true, 100));
+        ASSERT_NE(jobs.back(), GSYS_JOB_INVALID);
+    }
+    run_ms(2);
+
+    due_launches = 0;
+    auto start = std::chrono::steady_clock::now();
+    run_ms(PASSES);
+    auto end = std::chrono::steady_clock::now();
+    double pass_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / PASSES;
+    EXPECT_EQ(due_launches, JOBS * PASSES);
+
+    volatile uint32_t sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < PASSES; i++) {
+        for (uint32_t j = 0; j < JOBS; j++) {
+            sink = sink + is_status(SYSTEM_ERROR_HANDLER_CALLED) + is_mcu_internal_error() + (uint32_t)system_micros();
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    double per_job_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / PASSES;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < PASSES; i++) {
+        sink = sink + get_soul_generation() + (uint32_t)system_micros();
+    }
+    end = std::chrono::steady_clock::now();
+    double snapshot_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / PASSES;
+
+    printf("  %u due jobs: %.1f ns per pass\n", JOBS, pass_ns);
+    printf("  state checks: %.1f ns per pass checked per job (before), %.1f ns per pass snapshot (after)\n", per_job_ns, snapshot_ns);
+    EXPECT_LT(snapshot_ns, per_job_ns);
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+}
+
+/*
+ * Tick cost versus the number of sleeping jobs: the deadline-ordered queue
+ * only looks at its top, the reference linear scan walks every job the way
+ * the table scheduler did before the queue.
+ */
+TEST_F(ProcTest, TickCostVersusJobCount)
+{
+    static constexpr uint32_t PASSES = 20000;
+    const unsigned counts[] = {8, 16, 32, 64};
+
+    std::vector<gsys_job_t> jobs;
+    std::vector<uint64_t> next_us;
+    double heap_ns[__arr_len(counts)] = {};
+
+    printf("  jobs | heap pass (ns) | linear scan (ns)\n");
+    for (unsigned c = 0; c < __arr_len(counts); c++) {
+        while (jobs.size() < counts[c]) {
+            jobs.push_back(system_register(sleeping_job, SLEEP_PERIOD_MS, true, true, 100));
+            ASSERT_NE(jobs.back(), GSYS_JOB_INVALID);
+            next_us.push_back(system_micros() + (uint64_t)SLEEP_PERIOD_MS * MILLIS_US);
+        }
+        system_tick();
+
+        heap_ns[c] = pass_cost_ns(PASSES);
+
+        volatile uint32_t due = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < PASSES; i++) {
+            uint64_t now_us = system_micros();
+            for (uint64_t job_us : next_us) {
+                due = due + (job_us <= now_us);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double linear_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / PASSES;
+
+        printf("  %4u | %14.1f | %16.1f\n", counts[c], heap_ns[c], linear_ns);
+    }
+
+    EXPECT_EQ(sleeping_launches, 0U);
+    // The pass cost does not grow with the sleeping jobs (generous bound for noisy hosts)
+    EXPECT_LT(heap_ns[__arr_len(counts) - 1], 4 * heap_ns[0] + 50);
+
+    for (gsys_job_t job : jobs) {
+        EXPECT_TRUE(system_job_remove(job));
+    }
+}
+
+/*
+ * The 32-bit millisecond time wraps every ~49.7 days: the launch times are
+ * 64-bit microseconds and the polled timers count the elapsed time modulo
+ * 2^32, so the jobs keep their period and the timers expire on time over
+ * the wraps. The idle time up to each wrap is skipped in one step (like a
+ * tickless sleep), the jobs queued before it are launched once after it.
+ */
+TEST_F(ProcTest, PeriodsAcrossMillisecondWraps)
+{
+    static constexpr uint32_t PERIOD_MS = 7;
+    static constexpr uint32_t TIMER_MS  = 200;
+    static constexpr uint32_t WINDOW_MS = 300;
+    static constexpr uint64_t WRAP_MS   = 0x100000000ULL;
+
+    gsys_job_t job = system_register(phase_job<0>, PERIOD_MS, true, true, 100);
+    ASSERT_NE(job, GSYS_JOB_INVALID);
+
+    for (uint64_t wrap = 1; wrap <= 2; wrap++) {
+        host_advance_us((wrap * WRAP_MS - WINDOW_MS / 2 - system_millis64()) * MILLIS_US);
+        system_tick();
+        EXPECT_EQ(phase_launches[0].size(), 1U) << "wrap " << wrap;
+        phase_launches[0].clear();
+
+        // Started before the wrap, expires after it
+        system_timer_t timer = {};
+        system_timer_start(&timer, TIMER_MS);
+        uint64_t start_ms   = system_millis64();
+        uint64_t expired_ms = 0;
+        for (uint32_t i = 0; i < WINDOW_MS; i++) {
+            run_ms(1);
+            if (!expired_ms && system_timer_wait(&timer)) {
+                expired_ms = system_millis64();
+            }
+        }
+        EXPECT_GT(start_ms + TIMER_MS, wrap * WRAP_MS);
+        EXPECT_EQ(expired_ms, start_ms + TIMER_MS + 1) << "wrap " << wrap;
+        EXPECT_LT(system_millis(), WINDOW_MS);
+        EXPECT_EQ(system_millis64(), wrap * WRAP_MS + WINDOW_MS / 2);
+
+        // No burst and no stall at the wrap
+        ASSERT_GE(phase_launches[0].size(), WINDOW_MS / PERIOD_MS - 1) << "wrap " << wrap;
+        EXPECT_LE(phase_launches[0].size(), WINDOW_MS / PERIOD_MS + 1) << "wrap " << wrap;
+        for (size_t n = 1; n < phase_launches[0].size(); n++) {
+            EXPECT_EQ(phase_launches[0][n] - phase_launches[0][n - 1], PERIOD_MS * MILLIS_US) << "wrap " << wrap;
+        }
+        phase_launches[0].clear();
+    }
+
+    EXPECT_TRUE(system_job_remove(job));
+}
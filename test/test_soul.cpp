@@ -0,0 +1,198 @@
+/*
+ * @file test_soul.cpp
+ * @brief Soul bitmap tests: the word scan of the error range and its cost,
+ *        concurrent bit updates in one word, the flight recorder records.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "soul.h"
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_soul_log_init();
+
+
+/* @brief Reference scan: every error value is checked one by one */
+static SOUL_STATUS first_error_by_values()
+{
+    for (unsigned error = ERRORS_START + 1; error < ERRORS_END; error++) {
+        if (is_error(error)) {
+            return (SOUL_STATUS)error;
+        }
+    }
+    return NO_ERROR;
+}
+
+template<typename F>
+static double call_cost_ns(F call)
+{
+    static constexpr uint32_t CALLS = 200000;
+
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < CALLS; i++) {
+        sink = sink + (uint32_t)call();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / CALLS;
+}
+
+
+TEST(SoulTest, FirstErrorMatchesTheValueScan)
+{
+    EXPECT_FALSE(has_errors());
+    EXPECT_EQ(get_first_error(), NO_ERROR);
+
+    const SOUL_STATUS errors[] = {INTERNAL_ERROR, HARD_FAULT, (SOUL_STATUS)(ERRORS_START + 1)};
+    for (SOUL_STATUS error : errors) {
+        set_error(error);
+        EXPECT_TRUE(has_errors());
+        EXPECT_EQ(get_first_error(), first_error_by_values());
+        EXPECT_EQ(get_first_error(), error);
+    }
+    for (SOUL_STATUS error : errors) {
+        reset_error(error);
+    }
+
+    // Statuses are not errors
+    set_status(SYSTEM_SOFTWARE_STARTED);
+    EXPECT_FALSE(has_errors());
+    reset_status(SYSTEM_SOFTWARE_STARTED);
+}
+
+/*
+ * Cost of the error range checks: the empty range is the worst case of both
+ * scans, the last error is found by the value scan after all the others.
+ */
+TEST(SoulTest, WordScanCost)
+{
+    printf("  case       | has_errors (ns) | get_first_error (ns) | value scan (ns)\n");
+
+    auto report = [](const char* name) {
+        double any_ns   = call_cost_ns([] { return has_errors(); });
+        double first_ns = call_cost_ns([] { return get_first_error(); });
+        double scan_ns  = call_cost_ns([] { return first_error_by_values(); });
+        printf("  %-10s | %15.1f | %20.1f | %15.1f\n", name, any_ns, first_ns, scan_ns);
+        EXPECT_LT(first_ns, scan_ns);
+    };
+
+    report("no errors");
+    set_error(INTERNAL_ERROR);
+    report("last error");
+    reset_error(INTERNAL_ERROR);
+}
+
+/*
+ * The main loop and an interrupt handler (a thread here) change different
+ * bits of one bitmap word: every transition is kept and counted once, the
+ * neighbour bit set through all the run is never touched.
+ */
+TEST(SoulTest, ConcurrentBitsInOneWord)
+{
+    static constexpr uint32_t TOGGLES = 200000;
+
+    static constexpr SOUL_STATUS MAIN_BIT = RESERVED_STATUS_01;
+    static constexpr SOUL_STATUS ISR_BIT  = RESERVED_STATUS_02;
+    static constexpr SOUL_STATUS HELD_BIT = RESERVED_STATUS_03;
+    static_assert(
+        MAIN_BIT / 32 == ISR_BIT / 32 && ISR_BIT / 32 == HELD_BIT / 32,
+        "The bits must share a bitmap word"
+    );
+
+    set_status(HELD_BIT);
+    uint32_t start_generation = get_soul_generation();
+
+    auto hammer = [](SOUL_STATUS status, std::atomic<uint32_t>* lost) {
+        for (uint32_t i = 0; i < TOGGLES; i++) {
+            set_status(status);
+            if (!is_status(status) || !is_status(HELD_BIT)) {
+                (*lost)++;
+            }
+            reset_status(status);
+            if (is_status(status) || !is_status(HELD_BIT)) {
+                (*lost)++;
+            }
+        }
+    };
+
+    std::atomic<uint32_t> main_lost(0);
+    std::atomic<uint32_t> isr_lost(0);
+    std::thread isr(hammer, ISR_BIT, &isr_lost);
+    hammer(MAIN_BIT, &main_lost);
+    isr.join();
+
+    EXPECT_EQ(main_lost, 0U);
+    EXPECT_EQ(isr_lost, 0U);
+    EXPECT_FALSE(is_status(MAIN_BIT));
+    EXPECT_FALSE(is_status(ISR_BIT));
+    EXPECT_TRUE(is_status(HELD_BIT));
+    // Two threads, a set and a reset per toggle
+    EXPECT_EQ(get_soul_generation() - start_generation, 4 * TOGGLES);
+
+    reset_status(HELD_BIT);
+}
+
+TEST(SoulTest, FlightRecorderKeepsTheTransitions)
+{
+    // The log is opened by system_init() on the target
+    sys_soul_log_init();
+    uint32_t boot = 0;
+    {
+        set_status(RESERVED_STATUS_04);
+        gsys_soul_record_t record = {};
+        ASSERT_TRUE(system_soul_log_get(0, &record));
+        boot = GSYS_SOUL_RECORD_BOOT(&record);
+        reset_status(RESERVED_STATUS_04);
+    }
+
+    // A warm reset: the records are kept, the boot counter goes on
+    sys_soul_log_init();
+    set_error(INTERNAL_ERROR);
+    reset_error(INTERNAL_ERROR);
+
+    const struct {
+        SOUL_STATUS status;
+        bool        set;
+        uint32_t    boot;
+    } expected[] = {
+        {INTERNAL_ERROR,     false, boot + 1},
+        {INTERNAL_ERROR,     true,  boot + 1},
+        {RESERVED_STATUS_04, false, boot},
+        {RESERVED_STATUS_04, true,  boot},
+    };
+    ASSERT_GE(system_soul_log_count(), __arr_len(expected));
+    for (unsigned i = 0; i < __arr_len(expected); i++) {
+        gsys_soul_record_t record = {};
+        ASSERT_TRUE(system_soul_log_get(i, &record)) << "record " << i;
+        EXPECT_EQ(record.status, expected[i].status) << "record " << i;
+        EXPECT_EQ(GSYS_SOUL_RECORD_SET(&record), expected[i].set) << "record " << i;
+        EXPECT_EQ(GSYS_SOUL_RECORD_BOOT(&record), (expected[i].boot & 0x7F)) << "record " << i;
+    }
+}
+
+TEST(SoulTest, StatusNames)
+{
+    EXPECT_STREQ(get_status_name(MEMORY_ERROR), "MEMORY_ERROR");
+    EXPECT_STREQ(get_status_name(SYSTEM_HARDWARE_READY), "SYSTEM_HARDWARE_READY");
+    // The custom status registered with GSYSTEM_CUSTOM_STATUS_NAMES of the host gconfig.h
+    EXPECT_STREQ(get_status_name((SOUL_STATUS)HOST_CUSTOM_STATUS), "HOST_CUSTOM_STATUS");
+
+    // The section markers keep their old name
+    const SOUL_STATUS markers[] = {STATUSES_START, STATUSES_END, NO_ERROR, ERRORS_START, ERRORS_END, SOUL_STATUSES_END};
+    for (SOUL_STATUS marker : markers) {
+        EXPECT_STREQ(get_status_name(marker), "EMPTY STATUS") << (unsigned)marker;
+    }
+
+    // Unnamed reserved and out of range statuses
+    EXPECT_EQ(get_status_name(RESERVED_ERROR_01), SOUL_UNKNOWN_STATUS);
+    EXPECT_EQ(get_status_name((SOUL_STATUS)(SOUL_STATUSES_END + 1)), SOUL_UNKNOWN_STATUS);
+}
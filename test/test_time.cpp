@@ -0,0 +1,175 @@
+/*
+ * @file test_time.cpp
+ * @brief System time tests: the lock-free micros reader against a simulated
+ *        overflowing timer, the 64-bit time over the counter wraps.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <sys/time.h>
+
+#include "drivers.h"
+#include "host.h"
+
+
+static constexpr uint32_t PERIOD_TICKS = MILLIS_US;
+
+/*
+ * The simulated system timer runs in a POSIX timer signal handler on the
+ * reader thread: like an interrupt it comes between any two instructions of
+ * the reader and the reader never sees it half done. Every signal either
+ * advances the counter by a few counts (the overflow wraps the counter and
+ * raises UIF in one step) or, once the counter reaches the varying tick
+ * latency, handles the pending overflow as the system tick interrupt. The
+ * tick is handled within half of the period.
+ */
+static uint32_t sim_seed    = 1;
+static uint32_t sim_tick_at = 0;
+
+static uint32_t sim_random(uint32_t range)
+{
+    sim_seed = sim_seed * 1103515245U + 12345U;
+    return (sim_seed >> 16) % range;
+}
+
+static void timer_signal(int)
+{
+    if ((host_tim1.SR & TIM_SR_UIF) && host_tim1.CNT >= sim_tick_at) {
+        host_tim1.SR = 0;
+        g_sys_time_add(1);
+        return;
+    }
+    uint32_t cnt = host_tim1.CNT + 1 + sim_random(40);
+    if (cnt >= PERIOD_TICKS) {
+        host_tim1.SR = TIM_SR_UIF;
+        cnt -= PERIOD_TICKS;
+        sim_tick_at = sim_random(PERIOD_TICKS / 2 - 40);
+    }
+    host_tim1.CNT = cnt;
+}
+
+class TimeTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        struct sigaction action = {};
+        action.sa_handler = timer_signal;
+        sigemptyset(&action.sa_mask);
+        ASSERT_EQ(sigaction(SIGALRM, &action, NULL), 0);
+
+        host_tim1.ARR    = PERIOD_TICKS - 1;
+        host_tim1.CNT    = 0;
+        host_tim1.SR     = 0;
+        sys_time_ms      = 0;
+        sys_time_ms_half = 0;
+    }
+};
+
+
+TEST_F(TimeTest, MicrosAreMonotonicOverTimerOverflows)
+{
+    static constexpr uint32_t TICKS = 300;
+
+    // Cross the bit 31 of the millisecond counter on the way
+    sys_time_ms = 0x80000000UL - TICKS / 2;
+
+    struct itimerval timer = {};
+    timer.it_interval.tv_usec = 20;
+    timer.it_value.tv_usec    = 20;
+    ASSERT_EQ(setitimer(ITIMER_REAL, &timer, NULL), 0);
+
+    uint64_t start_us = g_sys_time_us(TIM1);
+    uint64_t prev_us  = start_us;
+    uint64_t reads    = 0;
+    uint64_t errors   = 0;
+    while (sys_time_ms - (0x80000000UL - TICKS / 2) < TICKS) {
+        uint64_t now_us = g_sys_time_us(TIM1);
+        if (now_us < prev_us) {
+            if (!errors++) {
+                ADD_FAILURE() << "time went from " << prev_us << " to " << now_us << " us";
+            }
+        }
+        prev_us = now_us;
+        reads++;
+    }
+
+    timer = {};
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    printf("  %lu reads over %u timer overflows\n", (unsigned long)reads, TICKS);
+    EXPECT_EQ(errors, 0U);
+    EXPECT_EQ(sys_time_ms_half, 1U);
+    EXPECT_GE(prev_us - start_us, (uint64_t)(TICKS - 2) * MILLIS_US);
+}
+
+TEST_F(TimeTest, Millis64AcrossCounterWraps)
+{
+    // Start before the bit 31 transition and run over two full counter wraps
+    static constexpr uint64_t START_MS = 0x80000000ULL - 10;
+    sys_time_ms = (uint32_t)START_MS;
+
+    uint64_t expected_ms = START_MS;
+    while (expected_ms < START_MS + 0x200000000ULL) {
+        // Millisecond steps around the bit 31 transitions, large steps in between
+        uint64_t to_edge_ms = 0x80000000ULL - expected_ms % 0x80000000ULL;
+        uint32_t step = (to_edge_ms <= 10 || expected_ms % 0x80000000ULL < 10) ? 1 : (uint32_t)std::min<uint64_t>(to_edge_ms - 10, 0x100000);
+        g_sys_time_add(step);
+        expected_ms += step;
+        ASSERT_EQ(g_sys_time_read_ms64(), expected_ms);
+    }
+    EXPECT_EQ(sys_time_ms_half, 4U);
+}
+
+/*
+ * The tick handled between the reads: the half-period counter read first
+ * lags the counter by one step at most, which is corrected.
+ */
+TEST_F(TimeTest, TickBetweenTheReads)
+{
+    sys_time_ms = 0x7FFFFFF0UL;
+
+    for (uint32_t i = 0; i < 0x40; i++) {
+        uint32_t half = sys_time_ms_half;
+        g_sys_time_add(1);
+        uint32_t ms = sys_time_ms;
+
+        uint64_t expected_ms = 0x7FFFFFF0ULL + i + 1;
+        ASSERT_EQ(g_sys_time_ms64(half, ms), expected_ms);
+    }
+}
+
+TEST_F(TimeTest, PendingOverflowIsCounted)
+{
+    sys_time_ms   = 41;
+    host_tim1.CNT = 3;
+    host_tim1.SR  = TIM_SR_UIF;
+    EXPECT_EQ(g_sys_time_us(TIM1), 42U * MILLIS_US + 3);
+
+    // The flag of the next overflow is not counted at the end of the period
+    host_tim1.CNT = PERIOD_TICKS - 2;
+    EXPECT_EQ(g_sys_time_us(TIM1), 41U * MILLIS_US + PERIOD_TICKS - 2);
+}
+
+TEST_F(TimeTest, ReadCost)
+{
+    static constexpr uint32_t READS = 1000000;
+
+    sys_time_ms   = 1;
+    host_tim1.CNT = PERIOD_TICKS / 3;
+    volatile uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < READS; i++) {
+        sink = sink + g_sys_time_us(TIM1);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / READS;
+
+    printf("  g_sys_time_us: %.2f ns per read\n", ns);
+    EXPECT_GT(sink, 0U);
+}
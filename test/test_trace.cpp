@@ -0,0 +1,82 @@
+/*
+ * @file test_trace.cpp
+ * @brief Scheduler trace ring tests: record layout, long durations and the ring order.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_trace_record(uint8_t job_id, uint64_t start_us, uint32_t duration_us, uint8_t flags);
+
+
+struct TraceRecord {
+    uint32_t start_us;
+    uint32_t duration_us;
+    uint8_t  job_id;
+    uint8_t  flags;
+    uint16_t seq;
+};
+
+static std::vector<uint8_t> dump;
+
+static void dump_write(const uint8_t* data, uint32_t len)
+{
+    dump.insert(dump.end(), data, data + len);
+}
+
+static std::vector<TraceRecord> dump_records()
+{
+    dump.clear();
+    system_trace_dump(dump_write);
+
+    uint32_t header[4] = {};
+    EXPECT_GE(dump.size(), sizeof(header));
+    memcpy(header, dump.data(), sizeof(header));
+    EXPECT_EQ(header[0], 0x43525447U);                // "GTRC"
+    EXPECT_EQ(header[1] & 0xFFFF, 2U);                // Version
+    EXPECT_EQ(header[1] >> 16, sizeof(TraceRecord));  // Record size
+
+    size_t offset = sizeof(header) + header[3] * 2 * sizeof(uint32_t);
+    EXPECT_EQ(dump.size(), offset + header[2] * sizeof(TraceRecord));
+    std::vector<TraceRecord> records(header[2]);
+    memcpy(records.data(), dump.data() + offset, records.size() * sizeof(TraceRecord));
+    return records;
+}
+
+
+TEST(TraceTest, KeepsLongDurations)
+{
+    system_trace_clear();
+    sys_trace_record(3, 1000, 250 * MILLIS_US, 0);
+
+    std::vector<TraceRecord> records = dump_records();
+    ASSERT_EQ(records.size(), 1U);
+    EXPECT_EQ(records[0].job_id, 3);
+    EXPECT_EQ(records[0].start_us, 1000U);
+    EXPECT_EQ(records[0].duration_us, 250 * MILLIS_US);
+}
+
+TEST(TraceTest, DumpsTheLastRecordsOldestFirst)
+{
+    system_trace_clear();
+    for (uint32_t i = 0; i < 3 * GSYSTEM_TRACE_SIZE + 5; i++) {
+        sys_trace_record((uint8_t)(i % 100), i, i, 1);
+    }
+
+    std::vector<TraceRecord> records = dump_records();
+    ASSERT_EQ(records.size(), (size_t)GSYSTEM_TRACE_SIZE);
+    uint32_t first = 2 * GSYSTEM_TRACE_SIZE + 5;
+    for (uint32_t i = 0; i < records.size(); i++) {
+        EXPECT_NE(records[i].job_id, 0xFF) << i;
+        EXPECT_EQ(records[i].start_us, first + i);
+        EXPECT_EQ(records[i].flags, 1);
+    }
+}
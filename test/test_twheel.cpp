@@ -0,0 +1,193 @@
+/*
+ * @file test_twheel.cpp
+ * @brief Timer wheel tests: cascades, periodic catch-up, stop and restart
+ *        from the callbacks and the empty span skipping.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_twheel_tick();
+extern "C" uint64_t sys_twheel_next_ms();
+
+
+struct Fired {
+    std::vector<uint64_t> at_ms;
+};
+
+static void record(void* arg)
+{
+    static_cast<Fired*>(arg)->at_ms.push_back(system_millis64());
+}
+
+class TwheelTest : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        EXPECT_EQ(sys_twheel_next_ms(), UINT64_MAX) << "the test left active timers";
+    }
+
+    static void run_ms(uint32_t ms)
+    {
+        for (uint32_t i = 0; i < ms; i++) {
+            host_advance_us(MILLIS_US);
+            sys_twheel_tick();
+        }
+    }
+};
+
+
+TEST_F(TwheelTest, UpperLevelsCascadeToTheExactMillisecond)
+{
+    // Levels 0, 1, 2 and 3 of the 32-slot wheel
+    const uint32_t delays_ms[] = {7, 45, 1500, 40000};
+    gsys_wtimer_t timers[__arr_len(delays_ms)] = {};
+    Fired fired[__arr_len(delays_ms)];
+
+    uint64_t start_ms = system_millis64();
+    for (unsigned i = 0; i < __arr_len(delays_ms); i++) {
+        ASSERT_TRUE(system_wtimer_start(&timers[i], delays_ms[i], 0, record, &fired[i]));
+    }
+    run_ms(delays_ms[__arr_len(delays_ms) - 1] + 10);
+
+    for (unsigned i = 0; i < __arr_len(delays_ms); i++) {
+        ASSERT_EQ(fired[i].at_ms.size(), 1U) << "timer " << delays_ms[i];
+        EXPECT_EQ(fired[i].at_ms[0], start_ms + delays_ms[i]);
+        EXPECT_FALSE(system_wtimer_active(&timers[i]));
+    }
+}
+
+TEST_F(TwheelTest, PeriodicTimerSkipsTheMissedPeriods)
+{
+    static constexpr uint32_t PERIOD_MS  = 10;
+    static constexpr uint32_t BLOCKED_MS = 95;
+
+    gsys_wtimer_t timer = {};
+    Fired fired;
+    uint64_t start_ms = system_millis64();
+    ASSERT_TRUE(system_wtimer_start(&timer, PERIOD_MS, PERIOD_MS, record, &fired));
+    run_ms(PERIOD_MS);
+    ASSERT_EQ(fired.at_ms.size(), 1U);
+
+    // The main loop is blocked: one late launch instead of a burst
+    host_advance_us((uint64_t)BLOCKED_MS * MILLIS_US);
+    sys_twheel_tick();
+    ASSERT_EQ(fired.at_ms.size(), 2U);
+    uint64_t late_ms = start_ms + PERIOD_MS + BLOCKED_MS;
+    EXPECT_EQ(fired.at_ms[1], late_ms);
+
+    // The period is counted from the late launch
+    run_ms(3 * PERIOD_MS);
+    ASSERT_EQ(fired.at_ms.size(), 5U);
+    for (unsigned i = 2; i < fired.at_ms.size(); i++) {
+        EXPECT_EQ(fired.at_ms[i], late_ms + (i - 1) * PERIOD_MS);
+    }
+
+    system_wtimer_stop(&timer);
+}
+
+static gsys_wtimer_t peer_timer = {};
+static Fired         peer_fired;
+
+static void stop_peer(void* arg)
+{
+    record(arg);
+    system_wtimer_stop(&peer_timer);
+}
+
+static gsys_wtimer_t self_timer = {};
+
+static void stop_self(void* arg)
+{
+    record(arg);
+    system_wtimer_stop(&self_timer);
+}
+
+static void restart_self(void* arg)
+{
+    record(arg);
+    if (static_cast<Fired*>(arg)->at_ms.size() < 3) {
+        system_wtimer_start(&self_timer, 5, 0, restart_self, arg);
+    }
+}
+
+TEST_F(TwheelTest, StopInsideTheCallback)
+{
+    // The peer expires in the same millisecond (the same detached slot list)
+    gsys_wtimer_t timer = {};
+    Fired fired;
+    ASSERT_TRUE(system_wtimer_start(&peer_timer, 20, 0, record, &peer_fired));
+    ASSERT_TRUE(system_wtimer_start(&timer, 20, 0, stop_peer, &fired));
+    run_ms(30);
+    EXPECT_EQ(fired.at_ms.size(), 1U);
+    EXPECT_EQ(peer_fired.at_ms.size(), 0U);
+    EXPECT_FALSE(system_wtimer_active(&peer_timer));
+
+    // The periodic timer stops itself after the first launch
+    Fired self_fired;
+    ASSERT_TRUE(system_wtimer_start(&self_timer, 3, 3, stop_self, &self_fired));
+    run_ms(20);
+    EXPECT_EQ(self_fired.at_ms.size(), 1U);
+    EXPECT_FALSE(system_wtimer_active(&self_timer));
+
+    // The one shot timer restarts itself twice
+    Fired restart_fired;
+    ASSERT_TRUE(system_wtimer_start(&self_timer, 5, 0, restart_self, &restart_fired));
+    run_ms(30);
+    ASSERT_EQ(restart_fired.at_ms.size(), 3U);
+    EXPECT_EQ(restart_fired.at_ms[1] - restart_fired.at_ms[0], 5U);
+    EXPECT_EQ(restart_fired.at_ms[2] - restart_fired.at_ms[1], 5U);
+    EXPECT_FALSE(system_wtimer_active(&self_timer));
+}
+
+TEST_F(TwheelTest, NextMillisecondStopsAtTheCascadeBoundary)
+{
+    gsys_wtimer_t timer = {};
+    Fired fired;
+    run_ms(32 - (uint32_t)(system_millis64() % 32) + 1);
+    uint64_t start_ms = system_millis64();
+    ASSERT_TRUE(system_wtimer_start(&timer, 100, 0, record, &fired));
+    sys_twheel_tick();
+
+    // Level 1 timer: the wheel sleeps up to the next level 0 wrap only
+    uint64_t next_ms = sys_twheel_next_ms();
+    EXPECT_GT(next_ms, start_ms);
+    EXPECT_EQ(next_ms % 32, 0U);
+
+    run_ms(100);
+    ASSERT_EQ(fired.at_ms.size(), 1U);
+    EXPECT_EQ(fired.at_ms[0], start_ms + 100);
+}
+
+/*
+ * A long idle time (tickless sleep, blocked main loop) is processed by spans:
+ * the empty level 0 slots up to the next cascade boundary are skipped at once.
+ */
+TEST_F(TwheelTest, LongIdleCatchUpCost)
+{
+    static constexpr uint32_t IDLE_MS = HOUR_MS;
+
+    gsys_wtimer_t timer = {};
+    Fired fired;
+    uint64_t start_ms = system_millis64();
+    ASSERT_TRUE(system_wtimer_start(&timer, IDLE_MS - 1, 0, record, &fired));
+
+    host_advance_us((uint64_t)IDLE_MS * MILLIS_US);
+    auto start = std::chrono::steady_clock::now();
+    sys_twheel_tick();
+    auto end = std::chrono::steady_clock::now();
+    double us = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1000;
+
+    printf("  %u ms of idle time: %.1f us\n", IDLE_MS, us);
+    ASSERT_EQ(fired.at_ms.size(), 1U);
+    EXPECT_EQ(fired.at_ms[0], start_ms + IDLE_MS);
+}
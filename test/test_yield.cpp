@@ -0,0 +1,146 @@
+/*
+ * @file test_yield.cpp
+ * @brief Cooperative delay tests: the other due jobs run during the wait,
+ *        the waiting job is not launched again and the nested scheduler
+ *        passes are out of the pass stats.
+ *
+ * Copyright © 2025 Georgy E. All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gsystem.h"
+#include "host.h"
+
+
+extern "C" void sys_jobs_init();
+
+
+static constexpr uint32_t WAIT_US = 5 * MILLIS_US;
+
+static std::vector<uint64_t> fast_launches;
+static uint32_t waiting_launches = 0;
+static uint32_t waiting_depth    = 0;
+static uint32_t max_depth        = 0;
+static uint64_t wait_start_us    = 0;
+static uint64_t wait_end_us      = 0;
+
+static void fast_job()
+{
+    fast_launches.push_back(system_micros());
+    system_delay_us(100);
+}
+
+static void waiting_job()
+{
+    waiting_launches++;
+    waiting_depth++;
+    max_depth = waiting_depth > max_depth ? waiting_depth : max_depth;
+
+    wait_start_us = system_micros();
+    system_yield_delay_us(WAIT_US);
+    wait_end_us = system_micros();
+
+    waiting_depth--;
+}
+
+
+class YieldTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        host_set_time_us(0);
+        sys_jobs_init();
+    }
+
+    void SetUp() override
+    {
+        // The yield loop waits for the running time
+        host_clock_step_us = 1;
+    }
+
+    void TearDown() override
+    {
+        host_clock_step_us = 0;
+    }
+
+    static void run_ms(uint32_t ms)
+    {
+        for (uint32_t i = 0; i < ms; i++) {
+            host_advance_us(MILLIS_US);
+            system_tick();
+        }
+    }
+};
+
+
+TEST_F(YieldTest, OtherJobsRunDuringTheWait)
+{
+    gsys_job_t fast = system_register(fast_job, 1, true, true, 100);
+    gsys_job_t wait = system_register(waiting_job, 50, true, true, 100);
+    ASSERT_NE(fast, GSYS_JOB_INVALID);
+    ASSERT_NE(wait, GSYS_JOB_INVALID);
+
+    for (uint32_t i = 0; i < 200 && !waiting_launches; i++) {
+        run_ms(1);
+    }
+    ASSERT_EQ(waiting_launches, 1U);
+    EXPECT_EQ(max_depth, 1U);
+    EXPECT_GE(wait_end_us - wait_start_us, WAIT_US);
+
+    // The 1 ms job keeps its period inside the 5 ms wait
+    uint32_t inside = 0;
+    for (uint64_t at_us : fast_launches) {
+        inside += (at_us > wait_start_us && at_us < wait_end_us) ? 1 : 0;
+    }
+    EXPECT_GE(inside, WAIT_US / MILLIS_US - 1);
+
+    EXPECT_TRUE(system_job_remove(fast));
+    EXPECT_TRUE(system_job_remove(wait));
+}
+
+TEST_F(YieldTest, ShortWaitAndInterruptsSpin)
+{
+    // Shorter than GSYSTEM_YIELD_MIN_US: no scheduler pass
+    fast_launches.clear();
+    gsys_job_t fast = system_register(fast_job, 1, true, true, 100);
+    ASSERT_NE(fast, GSYS_JOB_INVALID);
+    run_ms(2);
+    size_t launches = fast_launches.size();
+
+    uint64_t start_us = system_micros();
+    system_yield_delay_us(GSYSTEM_YIELD_MIN_US - 1);
+    EXPECT_GE(system_micros() - start_us, (uint64_t)GSYSTEM_YIELD_MIN_US - 1);
+    EXPECT_EQ(fast_launches.size(), launches);
+
+    // Interrupt handlers and masked interrupts spin as well
+    host_ipsr = 1;
+    system_yield_delay_us(2 * MILLIS_US);
+    host_ipsr = 0;
+    host_primask = 1;
+    system_yield_delay_us(2 * MILLIS_US);
+    host_primask = 0;
+    EXPECT_EQ(fast_launches.size(), launches);
+
+    EXPECT_TRUE(system_job_remove(fast));
+}
+
+TEST_F(YieldTest, NestedPassesAreNotCountedAsTicks)
+{
+    gsys_job_t wait = system_register(waiting_job, 10, true, true, 100);
+    ASSERT_NE(wait, GSYS_JOB_INVALID);
+    uint32_t launches = waiting_launches;
+
+    // Every 10 ms the waiting job runs 5 ms of nested passes
+    run_ms(3 * SECOND_MS);
+    EXPECT_GT(waiting_launches - launches, 100U);
+
+    gsys_scheduler_stats_t stats = {};
+    ASSERT_TRUE(system_get_scheduler_stats(&stats));
+    EXPECT_GT(stats.ticks_per_second, 0U);
+    EXPECT_LE(stats.ticks_per_second, SECOND_MS);
+
+    EXPECT_TRUE(system_job_remove(wait));
+}
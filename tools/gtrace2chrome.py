@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""
+Convert a gsystem scheduler trace dump (system_trace_dump()) to Chrome trace JSON.
+
+The dump may be embedded into a raw debug UART capture: the converter looks
+for the "GTRC" magic. Open the result in chrome://tracing or ui.perfetto.dev.
+
+Usage: gtrace2chrome.py dump.bin [-o trace.json] [--elf firmware.elf]
+
+Copyright © 2025 Georgy E. All rights reserved.
+"""
+
+import argparse
+import json
+import struct
+import subprocess
+import sys
+
+
+MAGIC         = b"GTRC"
+VERSION       = 2
+HEADER        = struct.Struct("<4sHHII")
+JOB           = struct.Struct("<II")
+RECORD        = struct.Struct("<IIBBH")
+JOB_LOST      = 0xFF
+DENY_REASONS  = {1: "error handler", 2: "MCU error"}
+
+
+def parse(data):
+    pos = data.find(MAGIC)
+    if pos < 0:
+        raise ValueError("trace magic is not found")
+
+    _, version, record_size, count, jobs_cnt = HEADER.unpack_from(data, pos)
+    if version != VERSION or record_size != RECORD.size:
+        raise ValueError(f"unsupported trace version {version} (record size {record_size})")
+    pos += HEADER.size
+
+    jobs = []
+    for _ in range(jobs_cnt):
+        jobs.append(JOB.unpack_from(data, pos))
+        pos += JOB.size
+
+    records = []
+    for _ in range(count):
+        records.append(RECORD.unpack_from(data, pos))
+        pos += RECORD.size
+
+    return jobs, records
+
+
+def resolve_names(jobs, elf):
+    names = {}
+    if not elf:
+        return names
+    addrs = [f"0x{addr & ~1:08x}" for addr, _ in jobs]
+    try:
+        out = subprocess.run(
+            ["arm-none-eabi-addr2line", "-f", "-C", "-e", elf, *addrs],
+            check=True, capture_output=True, text=True
+        ).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError) as e:
+        print(f"addr2line error: {e}", file=sys.stderr)
+        return names
+    for idx, func in enumerate(out[0::2]):
+        if func != "??":
+            names[idx] = func
+    return names
+
+
+def convert(jobs, records, names):
+    events = []
+    for tid, tier in ((0, "main loop"), (1, "ISR")):
+        events.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": tid, "args": {"name": tier}})
+
+    # Unwrap the 32-bit microseconds counter
+    base = 0
+    last = None
+    for start_us, duration_us, job_id, flags, _ in records:
+        # Records torn by the dump of a running trace
+        if job_id == JOB_LOST:
+            continue
+        if last is not None and start_us < last and last - start_us > 0x80000000:
+            base += 1 << 32
+        last = start_us
+
+        if job_id < len(jobs):
+            addr, period_us = jobs[job_id]
+        else:
+            addr, period_us = 0, 0
+        name = names.get(job_id, f"job {job_id:02d} (0x{addr:08X})")
+        tid = flags & 0x01
+        deny = (flags >> 1) & 0x03
+        ts = base + start_us
+
+        if deny:
+            events.append({
+                "ph": "i", "s": "t", "name": f"{name} denied", "pid": 0, "tid": tid, "ts": ts,
+                "args": {"reason": DENY_REASONS.get(deny, str(deny))}
+            })
+        else:
+            events.append({
+                "ph": "X", "name": name, "pid": 0, "tid": tid, "ts": ts, "dur": duration_us,
+                "args": {"job": job_id, "period_us": period_us}
+            })
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary trace dump or raw UART capture")
+    parser.add_argument("-o", "--output", default="-", help="output JSON file (default: stdout)")
+    parser.add_argument("--elf", help="firmware ELF to resolve job names with arm-none-eabi-addr2line")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        jobs, records = parse(f.read())
+
+    trace = convert(jobs, records, resolve_names(jobs, args.elf))
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+
+
+if __name__ == "__main__":
+    main()